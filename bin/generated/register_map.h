@@ -0,0 +1,146 @@
+/* Generated from config/register_map.txt by scripts/gen_register_map.awk - do not edit */
+
+#ifndef REGISTER_MAP_H
+#define REGISTER_MAP_H
+
+#include <stdint.h>
+#include "monitor.h"
+
+#define REGISTER_MAP_COUNT 16
+#define REGISTER_MAP_FIELD_COUNT 4
+
+// Register indices
+#define REGMAP_CTRL_REG 0
+#define REGMAP_STATUS_REG 1
+#define REGMAP_CONFIG_REG 2
+#define REGMAP_MODE_REG 3
+#define REGMAP_DATA_REG_0 4
+#define REGMAP_DATA_REG_1 5
+#define REGMAP_DATA_REG_2 6
+#define REGMAP_DATA_REG_3 7
+#define REGMAP_VOLTAGE_REG 8
+#define REGMAP_TEMP_REG 9
+#define REGMAP_CURRENT_REG 10
+#define REGMAP_POWER_REG 11
+#define REGMAP_ERROR_STATUS 12
+#define REGMAP_ERROR_COUNT 13
+#define REGMAP_ERROR_LOG 14
+#define REGMAP_ERROR_MASK 15
+
+static const char *const register_map_names[REGISTER_MAP_COUNT] = {
+    "CTRL_REG",
+    "STATUS_REG",
+    "CONFIG_REG",
+    "MODE_REG",
+    "DATA_REG_0",
+    "DATA_REG_1",
+    "DATA_REG_2",
+    "DATA_REG_3",
+    "VOLTAGE_REG",
+    "TEMP_REG",
+    "CURRENT_REG",
+    "POWER_REG",
+    "ERROR_STATUS",
+    "ERROR_COUNT",
+    "ERROR_LOG",
+    "ERROR_MASK",
+};
+
+static const uint32_t register_map_addresses[REGISTER_MAP_COUNT] = {
+    0x40000000u,
+    0x40000004u,
+    0x40000008u,
+    0x4000000Cu,
+    0x40000010u,
+    0x40000014u,
+    0x40000018u,
+    0x4000001Cu,
+    0x40000020u,
+    0x40000024u,
+    0x40000028u,
+    0x4000002Cu,
+    0x40000030u,
+    0x40000034u,
+    0x40000038u,
+    0x4000003Cu,
+};
+
+static const uint32_t register_map_min[REGISTER_MAP_COUNT] = {
+    0x10000000u,
+    0x10000000u,
+    0x10000000u,
+    0x10000000u,
+    0x12000000u,
+    0x12000000u,
+    0x12000000u,
+    0x12000000u,
+    0x0C000000u,
+    0x0A000000u,
+    0x08000000u,
+    0x0E000000u,
+    0x00000000u,
+    0x00000000u,
+    0x00000000u,
+    0x00000000u,
+};
+
+static const uint32_t register_map_max[REGISTER_MAP_COUNT] = {
+    0x20000000u,
+    0x20000000u,
+    0x20000000u,
+    0x20000000u,
+    0x18000000u,
+    0x18000000u,
+    0x18000000u,
+    0x18000000u,
+    0x14000000u,
+    0x16000000u,
+    0x18000000u,
+    0x1A000000u,
+    0x0000FFFFu,
+    0x000000FFu,
+    0xFFFFFFFFu,
+    0x0000FFFFu,
+};
+
+// Bitfield specs, terminated by an entry with reg = -1
+static const register_field_spec_t register_map_fields[REGISTER_MAP_FIELD_COUNT + 1] = {
+    {REGMAP_STATUS_REG, "STATE", 28, 4, 1u, 2u, (1u << 1) | (1u << 2)},
+    {REGMAP_ERROR_STATUS, "SEVERITY", 14, 2, 0u, 2u, 0},
+    {REGMAP_ERROR_STATUS, "SOURCE", 0, 4, 0u, 8u, (1u << 0) | (1u << 1) | (1u << 2) | (1u << 4) | (1u << 8)},
+    {REGMAP_ERROR_MASK, "RESERVED", 12, 4, 0u, 0u, 0},
+    {-1, 0, 0, 0, 0, 0, 0}
+};
+
+/**
+ * @brief Check the map's registers against their compile-time bounds and fields
+ * @param values REGISTER_MAP_COUNT values in map order
+ * @return Bitmap with bit i set if values[i] is within its bounds and
+ *         every field of register i holds an allowed value
+ */
+static inline uint32_t register_map_validity(const uint32_t *values) {
+    uint32_t bits = 0;
+    bits |= (uint32_t)(((uint32_t)(values[0] - 0x10000000u) <= 0x20000000u - 0x10000000u)) << 0;
+    bits |= (uint32_t)(((uint32_t)(values[1] - 0x10000000u) <= 0x20000000u - 0x10000000u)
+                       & ((((1u << 1) | (1u << 2)) >> ((values[1] >> 28) & ((1u << 4) - 1u))) & 1u)) << 1;
+    bits |= (uint32_t)(((uint32_t)(values[2] - 0x10000000u) <= 0x20000000u - 0x10000000u)) << 2;
+    bits |= (uint32_t)(((uint32_t)(values[3] - 0x10000000u) <= 0x20000000u - 0x10000000u)) << 3;
+    bits |= (uint32_t)(((uint32_t)(values[4] - 0x12000000u) <= 0x18000000u - 0x12000000u)) << 4;
+    bits |= (uint32_t)(((uint32_t)(values[5] - 0x12000000u) <= 0x18000000u - 0x12000000u)) << 5;
+    bits |= (uint32_t)(((uint32_t)(values[6] - 0x12000000u) <= 0x18000000u - 0x12000000u)) << 6;
+    bits |= (uint32_t)(((uint32_t)(values[7] - 0x12000000u) <= 0x18000000u - 0x12000000u)) << 7;
+    bits |= (uint32_t)(((uint32_t)(values[8] - 0x0C000000u) <= 0x14000000u - 0x0C000000u)) << 8;
+    bits |= (uint32_t)(((uint32_t)(values[9] - 0x0A000000u) <= 0x16000000u - 0x0A000000u)) << 9;
+    bits |= (uint32_t)(((uint32_t)(values[10] - 0x08000000u) <= 0x18000000u - 0x08000000u)) << 10;
+    bits |= (uint32_t)(((uint32_t)(values[11] - 0x0E000000u) <= 0x1A000000u - 0x0E000000u)) << 11;
+    bits |= (uint32_t)(((uint32_t)(values[12] - 0x00000000u) <= 0x0000FFFFu - 0x00000000u)
+                       & (((values[12] >> 14) & ((1u << 2) - 1u)) <= 2u)
+                       & ((((1u << 0) | (1u << 1) | (1u << 2) | (1u << 4) | (1u << 8)) >> ((values[12] >> 0) & ((1u << 4) - 1u))) & 1u)) << 12;
+    bits |= (uint32_t)(((uint32_t)(values[13] - 0x00000000u) <= 0x000000FFu - 0x00000000u)) << 13;
+    bits |= 1u << 14;  // ERROR_LOG accepts every value
+    bits |= (uint32_t)(((uint32_t)(values[15] - 0x00000000u) <= 0x0000FFFFu - 0x00000000u)
+                       & (((values[15] >> 12) & ((1u << 4) - 1u)) <= 0u)) << 15;
+    return bits;
+}
+
+#endif // REGISTER_MAP_H
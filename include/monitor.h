@@ -1,14 +1,24 @@
 #ifndef MONITOR_H
 #define MONITOR_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "register_transport.h"
+#include "report_sink.h"
+#include "register_arena.h"
+#include "register_phash.h"
+#include "register_names.h"
 
 // System constants
-#define MAX_REGISTERS 16
+#define MAX_REGISTERS 4096  // Largest register set one system can be sized for
 #define MAX_ERRORS 10
 #define MONITOR_INTERVAL 1000  // milliseconds
 
+// Memory-mapped register file window
+#define REGISTER_FILE_BASE 0x40000000u
+#define REGISTER_FILE_DEFAULT_SIZE 0x10000u  // Covers chip offsets up to 0xF000
+
 // Voltage thresholds (in Volts)
 #define MIN_VOLTAGE 3.0f
 #define MAX_VOLTAGE 3.6f
@@ -48,16 +58,55 @@ typedef enum {
     ERROR_INVALID_DATA = 8
 } error_code_t;
 
-// Register information structure
+#define REGISTER_NAME_LENGTH 32
+
+// Register information structure (one register's view of the register store)
 typedef struct {
     uint32_t address;
     uint32_t value;
     uint32_t expected_min;
     uint32_t expected_max;
     bool is_valid;
-    char name[32];
+    char name[REGISTER_NAME_LENGTH];
 } register_info_t;
 
+// 64-bit words in a bitmap with one bit per register
+#define REGISTER_BITMAP_WORDS(n) (((size_t)(n) + 63) / 64)
+
+// Register store: the fields touched by every scan, one contiguous array
+// each, sized for the system's register set and allocated from an arena
+typedef struct {
+    uint32_t *values;
+    uint32_t *min;
+    uint32_t *max;
+    uint32_t *addresses;
+    uint64_t *valid;     // Validity bitmap (bit i of word i / 64 refers to register i)
+    uint32_t *scratch;   // Three words per register, private to a single operation
+    int capacity;        // Registers the arrays have room for
+} register_store_t;
+
+// Bitfield validation spec: bits [shift, shift + width) of one register
+typedef struct {
+    int reg;           // Register index
+    const char *name;
+    uint8_t shift;
+    uint8_t width;
+    uint32_t min;      // Allowed field values are min..max ...
+    uint32_t max;
+    uint32_t allowed;  // ... or, if nonzero, the set bits of allowed (width <= 5)
+} register_field_spec_t;
+
+// Bitfield specs compiled into mask/compare vectors, one lane per field
+typedef struct {
+    int32_t *reg;
+    uint32_t *mask;     // Field bits in place
+    uint32_t *shift;
+    uint32_t *low;      // Lowest allowed field value
+    uint32_t *span;     // Highest minus lowest allowed field value
+    uint32_t *allowed;  // Allowed-value set, all ones for a range field
+    size_t count;
+} register_field_checks_t;
+
 // System monitoring structure
 typedef struct {
     float voltage;
@@ -66,10 +115,80 @@ typedef struct {
     system_status_t status;
     int error_count;
     bool system_active;
-    register_info_t registers[MAX_REGISTERS];
     int num_registers;
+    register_store_t regs;
+    const register_transport_t *transport;  // Selected at init_monitor_system()
+    uint32_t sim_sequence;                  // Simulated device state for this system
+
+    register_arena_t *arena;                // Arena the register store came from, NULL if owned
+    void *owned_store;                      // Store block owned by the system, or NULL
+    const register_field_checks_t *field_checks;  // Bitfield rules (set by load_register_map), or NULL for ranges only
+
+    // Shadow register cache (bitmaps with one bit per register)
+    uint32_t *shadow_values;
+    uint64_t *shadow_valid;   // Shadow holds the register's current contents
+    uint64_t *shadow_dirty;   // Written but not yet flushed to hardware
+    uint64_t *shadow_cached;  // Reads are served from the shadow
+
+    // Cold data, only touched when registers are named or reported
+    register_symbol_t *name_ids;   // Interned name of each register
+    int name_chip;                 // Names carry a "CHIP<n>_" prefix, or -1 for none
+    register_phash_t name_index;   // Name symbol -> register index
+    register_arena_t name_index_arena;  // Tables of name_index, emptied on every rebuild
+    bool name_index_stale;         // Registers renamed since name_index was built
 } monitor_system_t;
 
+// Register bitmap helpers
+static inline bool register_bit(const uint64_t *bitmap, int index) {
+    return (bitmap[index >> 6] >> (index & 63)) & 1u;
+}
+
+static inline void set_register_bit(uint64_t *bitmap, int index) {
+    bitmap[index >> 6] |= 1ull << (index & 63);
+}
+
+static inline void clear_register_bit(uint64_t *bitmap, int index) {
+    bitmap[index >> 6] &= ~(1ull << (index & 63));
+}
+
+// Register store accessors (index must be below num_registers)
+static inline uint32_t register_value(const monitor_system_t *system, int index) {
+    return system->regs.values[index];
+}
+
+static inline void set_register_value(monitor_system_t *system, int index, uint32_t value) {
+    system->regs.values[index] = value;
+}
+
+static inline uint32_t register_address(const monitor_system_t *system, int index) {
+    return system->regs.addresses[index];
+}
+
+static inline uint32_t register_min(const monitor_system_t *system, int index) {
+    return system->regs.min[index];
+}
+
+static inline uint32_t register_max(const monitor_system_t *system, int index) {
+    return system->regs.max[index];
+}
+
+static inline bool register_is_valid(const monitor_system_t *system, int index) {
+    return register_bit(system->regs.valid, index);
+}
+
+static inline void set_register_valid(monitor_system_t *system, int index, bool valid) {
+    if (valid) {
+        set_register_bit(system->regs.valid, index);
+    } else {
+        clear_register_bit(system->regs.valid, index);
+    }
+}
+
+// May intern the chip name: not for worker tasks (see register_names.h)
+static inline const char *register_name(const monitor_system_t *system, int index) {
+    return register_symbol_name(chip_register_symbol(system->name_chip, system->name_ids[index]));
+}
+
 // Function prototypes for Task 1: Conditional Logic
 bool validate_voltage_range(float voltage);
 bool validate_temperature_range(float temperature);
@@ -105,9 +224,199 @@ void emergency_shutdown(monitor_system_t *system);
 
 // Utility functions
 void init_monitor_system(monitor_system_t *system);
+void init_monitor_system_in(monitor_system_t *system, register_arena_t *arena);
+void release_register_set(monitor_system_t *system);
+bool allocate_register_set(monitor_system_t *system, register_arena_t *arena, int num_registers);
+void define_register(monitor_system_t *system, int index, uint32_t address,
+                     uint32_t min, uint32_t max, const char *name);
+bool get_register_info(const monitor_system_t *system, int index, register_info_t *info);
+bool set_register_info(monitor_system_t *system, int index, const register_info_t *info);
+void set_register_name(monitor_system_t *system, int index, const char *name);
+int find_register_by_name(monitor_system_t *system, const char *name);
+void seed_monitor_system(monitor_system_t *system, uint32_t seed);
 void cleanup_monitor_system(monitor_system_t *system);
 uint32_t read_register(uint32_t address);
 bool write_register(uint32_t address, uint32_t value);
+size_t read_registers_bulk(const uint32_t *addrs, uint32_t *out, size_t n);
+int read_system_registers_bulk(monitor_system_t *system);
+size_t write_registers_bulk(const uint32_t *addrs, const uint32_t *values, size_t n);
+
+// Integrity-checked register reads
+error_code_t read_system_registers_checked(monitor_system_t *system, int max_retries);
+
+// Batch register range validation
+size_t validate_registers_batch(const uint32_t *values, const uint32_t *min,
+                                const uint32_t *max, size_t n, uint64_t *valid_bitmap);
+int validate_system_registers(monitor_system_t *system);
+int count_register_bits(const uint64_t *bitmap, int num_registers);
+bool compile_register_fields(register_field_checks_t *checks, register_arena_t *arena,
+                             const register_field_spec_t *specs, size_t n, int num_registers);
+size_t validate_register_fields(const register_field_checks_t *checks, const uint32_t *values,
+                                uint64_t *valid_bitmap);
+bool register_fields_valid(const register_field_checks_t *checks, const uint32_t *values, int reg);
+int register_validity_mismatches(const monitor_system_t *a, const monitor_system_t *b);
+
+// Address -> (chip, register) index across a set of systems
+typedef struct {
+    int32_t chip;  // -1 if no register has the address
+    int32_t reg;
+} register_slot_t;
+
+typedef struct {
+    uint16_t first_word;  // Word offset of the page's first register
+    uint16_t words;       // Word offsets covered by the page's slots
+    uint32_t first_slot;  // Position of the page's slots in the slot table
+} register_index_page_t;
+
+typedef struct {
+    register_phash_t page_hash;    // Page number (address >> 12) -> page entry
+    register_index_page_t *pages;
+    register_slot_t *slots;
+    size_t num_pages;
+} register_address_index_t;
+
+bool build_register_address_index(register_address_index_t *index, register_arena_t *arena,
+                                  const monitor_system_t *const *systems, int num_systems);
+bool find_register_by_address(const register_address_index_t *index, uint32_t address,
+                              register_slot_t *slot);
+
+// Fork-join worker thread pool
+typedef struct worker_pool worker_pool_t;
+typedef void (*worker_task_fn)(void *arg, int worker, int num_workers);
+worker_pool_t *create_worker_pool(int num_workers);
+void destroy_worker_pool(worker_pool_t *pool);
+int worker_pool_size(const worker_pool_t *pool);
+void worker_pool_run(worker_pool_t *pool, worker_task_fn task, void *arg);
+
+// Work-stealing task scheduler over a worker pool
+typedef struct task_scheduler task_scheduler_t;
+typedef void (*task_fn)(void *context, uint32_t item, int worker);
+task_scheduler_t *create_task_scheduler(worker_pool_t *pool);
+void destroy_task_scheduler(task_scheduler_t *scheduler);
+int task_scheduler_workers(const task_scheduler_t *scheduler);
+void run_scheduled_tasks(task_scheduler_t *scheduler, uint32_t num_items, task_fn fn, void *context);
+
+// Hierarchical timer wheel: deadlines in whole ticks, one timer per id
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1u << TIMER_WHEEL_SLOT_BITS)  // Slots per level
+#define TIMER_NONE UINT32_MAX
+
+typedef struct {
+    uint64_t deadline;
+    uint32_t next;  // Next timer in the same slot, TIMER_NONE at the end
+    uint32_t prev;
+    uint32_t slot;  // level * TIMER_WHEEL_SLOTS + slot, TIMER_NONE if not scheduled
+} timer_entry_t;
+
+typedef struct {
+    timer_entry_t *timers;  // One entry per timer id
+    uint32_t slots[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];  // First timer of each slot
+    uint32_t capacity;
+    uint64_t now;           // Last tick advanced to
+} timer_wheel_t;
+
+typedef void (*timer_fn)(void *context, uint32_t timer, uint64_t deadline);
+bool timer_wheel_init(timer_wheel_t *wheel, uint32_t capacity);
+void timer_wheel_destroy(timer_wheel_t *wheel);
+bool timer_wheel_schedule(timer_wheel_t *wheel, uint32_t timer, uint64_t deadline);
+bool timer_wheel_cancel(timer_wheel_t *wheel, uint32_t timer);
+bool timer_wheel_pending(const timer_wheel_t *wheel, uint32_t timer);
+size_t timer_wheel_advance(timer_wheel_t *wheel, uint64_t tick, timer_fn fn, void *context);
+
+// Fleet of monitored chips, sized at runtime (multi_chip_monitor.c)
+#define MAX_FLEET_CHIPS 262144       // Keeps every chip's registers below 0x80000000
+#define CHIP_ADDRESS_STRIDE 0x1000u  // Register address offset between consecutive chips
+
+typedef struct {
+    _Alignas(REGISTER_ARENA_ALIGN) int chip_id;  // Every record starts on its own cache line
+    bool polled;          // Read asynchronously in the current monitoring iteration
+    int priority_level;   // 1=high, 2=medium, 3=low
+    uint32_t sample_period;  // Monitoring iterations between samples (priority_level by default)
+    monitor_system_t monitor;
+} chip_system_t;
+
+typedef struct {
+    int chip_id;
+    int reg_index;
+    uint32_t old_value;
+    uint32_t new_value;
+    bool is_valid;
+} register_change_t;
+
+typedef struct {
+    chip_system_t *chips;       // num_chips contiguous records, chip i at chips[i]
+    int num_chips;
+    uint64_t *active;           // Bit i set while chip i is monitored
+    int active_chip_count;      // Bits set in active
+    register_arena_t arena;     // Chip records, register stores and the address index
+    register_address_index_t address_index;
+} chip_fleet_t;
+
+typedef struct {
+    long pairs;                 // Pairs of active chips compared
+    long voltage_warnings;      // Pairs more than 0.2V apart
+    long temperature_warnings;  // Pairs more than 10°C apart
+    long pattern_warnings;      // Pairs with under 80% matching register validity
+} chip_correlation_summary_t;
+
+// Active chips are walked in chip order with
+//   for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip))
+// which may deactivate chips as it goes
+static inline bool chip_is_active(const chip_fleet_t *fleet, int chip) {
+    return chip >= 0 && chip < fleet->num_chips && register_bit(fleet->active, chip);
+}
+
+chip_fleet_t *create_chip_fleet(int num_chips);
+void destroy_chip_fleet(chip_fleet_t *fleet);
+int next_active_chip(const chip_fleet_t *fleet, int chip);
+bool deactivate_chip(chip_fleet_t *fleet, int chip);
+int list_active_chips(const chip_fleet_t *fleet, int *chips);
+size_t chip_fleet_footprint(const chip_fleet_t *fleet);
+bool apply_register_update(chip_fleet_t *fleet, uint32_t address, uint32_t value);
+int scan_all_chips_registers(chip_fleet_t *fleet);
+int scan_all_chips_registers_parallel(chip_fleet_t *fleet, task_scheduler_t *scheduler);
+int scan_all_chips_registers_delta(chip_fleet_t *fleet, register_change_t *changes, int max_changes);
+void priority_based_monitoring(chip_fleet_t *fleet, int duration_seconds);
+void cross_chip_correlation_analysis(const chip_fleet_t *fleet);
+bool summarize_chip_correlation(const chip_fleet_t *fleet, task_scheduler_t *scheduler,
+                                chip_correlation_summary_t *summary);
+int evaluate_fleet_status(chip_fleet_t *fleet);
+void optimized_batch_processing(chip_fleet_t *fleet, task_scheduler_t *scheduler);
+
+// Register map generated from config/register_map.txt (see register_map.h)
+int load_register_map(monitor_system_t *system);
+uint32_t validate_register_map(const uint32_t *values);
+
+// Batch sensor status classification (structure-of-arrays readings)
+system_status_t classify_system_status(float voltage, float temperature, float current);
+size_t determine_system_status_batch(const float *voltage, const float *temperature,
+                                     const float *current, size_t n, system_status_t *status);
+
+// Asynchronous register polling against the register file (bypasses transport, shadow and trace)
+typedef struct register_poller register_poller_t;
+register_poller_t *open_register_poller(unsigned depth);
+void close_register_poller(register_poller_t *poller);
+bool register_poller_is_async(const register_poller_t *poller);
+bool register_poller_submit(register_poller_t *poller, monitor_system_t *system);
+void register_poller_kick(register_poller_t *poller);
+int register_poller_reap(register_poller_t *poller, bool wait);
+
+// Shadow register cache
+uint32_t shadow_read_register(monitor_system_t *system, int index);
+bool shadow_write_register(monitor_system_t *system, int index, uint32_t value);
+int flush_shadow_registers(monitor_system_t *system);
+
+// Memory-mapped register file backend
+bool attach_register_file(const char *path, size_t size);
+bool attach_register_shm(const char *name, size_t size);
+void detach_register_file(void);
+bool register_file_attached(void);
+const char *register_file_path(void);
+size_t register_file_size(void);
+bool reserve_register_file(uint32_t end);
+bool register_file_read(uint32_t address, uint32_t *value);
+bool register_file_write(uint32_t address, uint32_t value);
 void delay_ms(int milliseconds);
 
 // Homework function prototypes
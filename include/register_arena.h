@@ -0,0 +1,35 @@
+#ifndef REGISTER_ARENA_H
+#define REGISTER_ARENA_H
+
+#include <stddef.h>
+
+/*
+ * Register arena
+ *
+ * Register stores are carved out of an arena instead of being allocated
+ * one array at a time: allocation is a pointer bump, the stores of many
+ * chips end up next to each other, and everything is released at once
+ * by resetting the arena. Memory is taken from the heap in blocks and
+ * individual allocations are never freed.
+ */
+
+// Alignment of every arena allocation (one cache line)
+#define REGISTER_ARENA_ALIGN 64
+
+// Default size of the blocks taken from the heap
+#define REGISTER_ARENA_DEFAULT_BLOCK (64u * 1024u)
+
+typedef struct register_arena_block register_arena_block_t;
+
+typedef struct {
+    register_arena_block_t *blocks;  // Newest block first
+    size_t block_size;               // Minimum size of a new block
+    size_t used;                     // Bytes handed out since the last reset
+} register_arena_t;
+
+void register_arena_init(register_arena_t *arena, size_t block_size);
+void *register_arena_alloc(register_arena_t *arena, size_t size);
+void register_arena_reset(register_arena_t *arena);
+register_arena_t *default_register_arena(void);
+
+#endif // REGISTER_ARENA_H
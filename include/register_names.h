@@ -0,0 +1,35 @@
+#ifndef REGISTER_NAMES_H
+#define REGISTER_NAMES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Interned register names
+ *
+ * Every distinct register name is stored once in a process-wide table
+ * and registers refer to it by a 32-bit symbol. Symbol 0 is the empty
+ * name, so a zeroed register store holds unnamed registers. Chip names
+ * ("CHIP<n>_<name>") are derived from the base symbol the first time
+ * they are asked for and interned like any other name; a chip name that
+ * would not fit in REGISTER_NAME_LENGTH falls back to the base name.
+ *
+ * The table is not locked. Interning, deriving chip names (and so
+ * register_name()) and renaming registers grow it, so they must run on
+ * the thread that owns the monitor systems, never inside scheduler or
+ * worker tasks; parallel scans report names after their tasks finish.
+ */
+
+typedef uint32_t register_symbol_t;
+
+#define REGISTER_SYMBOL_EMPTY 0u
+#define REGISTER_SYMBOL_NONE UINT32_MAX  // Unknown name, or the table is out of memory
+
+register_symbol_t intern_register_name(const char *name);
+register_symbol_t find_register_symbol(const char *name);
+const char *register_symbol_name(register_symbol_t symbol);
+register_symbol_t chip_register_symbol(int chip, register_symbol_t base);
+register_symbol_t register_symbol_base(register_symbol_t symbol, int chip);
+size_t register_symbol_count(void);
+
+#endif // REGISTER_NAMES_H
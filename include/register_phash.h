@@ -0,0 +1,32 @@
+#ifndef REGISTER_PHASH_H
+#define REGISTER_PHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "register_arena.h"
+
+/*
+ * Static perfect hash
+ *
+ * Maps a fixed set of distinct 32-bit keys to 32-bit values with one
+ * probe and no collisions (hash and displace): every key hashes to a
+ * bucket, and each bucket stores the seed that sends all its keys to
+ * free slots. Lookups of keys outside the set return -1. The tables are
+ * built once and are read-only afterwards, so any number of threads may
+ * look up concurrently.
+ */
+
+typedef struct {
+    uint32_t *seeds;   // Displacement seed of each bucket
+    uint32_t *keys;    // Key held by each slot
+    int32_t *values;   // Value held by each slot, -1 if the slot is empty
+    uint32_t bucket_mask;
+    uint32_t slot_mask;
+} register_phash_t;
+
+bool register_phash_build(register_phash_t *phash, register_arena_t *arena,
+                          const uint32_t *keys, const int32_t *values, size_t n);
+int32_t register_phash_lookup(const register_phash_t *phash, uint32_t key);
+
+#endif // REGISTER_PHASH_H
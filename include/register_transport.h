@@ -0,0 +1,182 @@
+#ifndef REGISTER_TRANSPORT_H
+#define REGISTER_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Register transport interface
+ *
+ * Every register access goes through a transport. The backend is picked
+ * at run time (see select_register_transport()), so one binary can run
+ * against the simulator, a memory-mapped register file or a recorded
+ * trace. Building with -DREGISTER_TRANSPORT_FIXED_SIM pins the simulated
+ * backend and lets the dispatch helpers below inline it into the scan
+ * loops with no indirect call; such a build warns about and ignores
+ * requests for any other backend or for trace recording.
+ */
+
+// Register transport backend
+typedef struct register_transport {
+    const char *name;
+    uint32_t (*read)(uint32_t address);
+    bool (*write)(uint32_t address, uint32_t value);
+    size_t (*read_bulk)(const uint32_t *addrs, uint32_t *out, size_t n);
+    size_t (*write_bulk)(const uint32_t *addrs, const uint32_t *values, size_t n);
+} register_transport_t;
+
+// Binary register trace file layout
+#define REGISTER_TRACE_MAGIC "RTRC"
+#define REGISTER_TRACE_VERSION 1
+
+typedef enum {
+    TRACE_OP_READ = 0,
+    TRACE_OP_WRITE = 1
+} register_trace_op_t;
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint64_t record_count;
+} register_trace_header_t;
+
+typedef struct {
+    uint64_t timestamp_ns;  // Monotonic time of the access
+    uint32_t address;
+    uint32_t value;
+    uint32_t thread_id;
+    uint32_t op;            // register_trace_op_t
+} register_trace_record_t;
+
+// Replay pacing
+typedef enum {
+    REPLAY_FULL_SPEED = 0,
+    REPLAY_RECORDED_TIMING = 1
+} replay_mode_t;
+
+// Built-in backends
+extern const register_transport_t simulated_transport;
+extern const register_transport_t file_transport;
+extern const register_transport_t replay_transport;
+extern const register_transport_t recording_transport;
+
+// Backend selection
+const register_transport_t *find_register_transport(const char *name);
+const register_transport_t *select_register_transport(void);
+const register_transport_t *get_register_transport(void);
+void set_register_transport(const register_transport_t *transport);
+
+// Trace recorder and replay backend
+bool start_register_trace(const char *path);
+long stop_register_trace(void);
+bool load_register_trace(const char *path);
+void unload_register_trace(void);
+void set_register_replay_mode(replay_mode_t mode);
+const register_transport_t *traced_register_transport(const register_transport_t *transport);
+void record_register_reads(const uint32_t *addrs, const uint32_t *values, size_t n);
+size_t register_replay_misses(void);
+
+/*
+ * Simulated backend state: number of simulated reads issued so far.
+ *
+ * Each thread has its own sequence, so simulated reads never share a
+ * cache line or race. Monitor systems carry their own sequence and bind
+ * it around their reads (see simulated_swap_sequence()), which keeps a
+ * chip's values reproducible whichever thread scans it.
+ */
+extern _Thread_local uint32_t simulated_read_sequence;
+
+/**
+ * @brief Make a sequence current for the calling thread
+ * @param sequence Sequence to bind
+ * @return The previously bound sequence
+ */
+static inline uint32_t simulated_swap_sequence(uint32_t sequence) {
+    uint32_t previous = simulated_read_sequence;
+    simulated_read_sequence = sequence;
+    return previous;
+}
+
+/**
+ * @brief Compute the simulated register value for a read sequence number
+ * @param sequence 1-based index of the read
+ * @return Simulated register value
+ */
+static inline uint32_t simulated_register_value(uint32_t sequence) {
+    // Base value with some variation
+    uint32_t base_value = 0x12345678;
+    uint32_t variation = (sequence % 16) << 4;
+
+    return base_value + variation;
+}
+
+/**
+ * @brief Simulated bulk read, identical to n consecutive single reads
+ */
+static inline size_t simulated_read_bulk(const uint32_t *addrs, uint32_t *out, size_t n) {
+    (void)addrs;
+
+    uint32_t first = simulated_read_sequence;
+    simulated_read_sequence += (uint32_t)n;
+
+    for (size_t i = 0; i < n; i++) {
+        out[i] = simulated_register_value(first + (uint32_t)i + 1);
+    }
+    return n;
+}
+
+/**
+ * @brief Read one register through a transport
+ */
+static inline uint32_t transport_read(const register_transport_t *transport, uint32_t address) {
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    (void)transport;
+    (void)address;
+    return simulated_register_value(++simulated_read_sequence);
+#else
+    return transport->read(address);
+#endif
+}
+
+/**
+ * @brief Write one register through a transport
+ */
+static inline bool transport_write(const register_transport_t *transport,
+                                   uint32_t address, uint32_t value) {
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    (void)transport;
+    return simulated_transport.write(address, value);
+#else
+    return transport->write(address, value);
+#endif
+}
+
+/**
+ * @brief Read a set of registers through a transport
+ */
+static inline size_t transport_read_bulk(const register_transport_t *transport,
+                                         const uint32_t *addrs, uint32_t *out, size_t n) {
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    (void)transport;
+    return simulated_read_bulk(addrs, out, n);
+#else
+    return transport->read_bulk(addrs, out, n);
+#endif
+}
+
+/**
+ * @brief Write a set of registers through a transport
+ */
+static inline size_t transport_write_bulk(const register_transport_t *transport,
+                                          const uint32_t *addrs, const uint32_t *values,
+                                          size_t n) {
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    (void)transport;
+    return simulated_transport.write_bulk(addrs, values, n);
+#else
+    return transport->write_bulk(addrs, values, n);
+#endif
+}
+
+#endif // REGISTER_TRANSPORT_H
@@ -0,0 +1,133 @@
+#ifndef REPORT_SINK_H
+#define REPORT_SINK_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Reporting sinks
+ *
+ * Validators and scan loops describe what happened as a report_event_t
+ * and hand it to the active sink instead of formatting text inline. The
+ * console sink (default) prints the classic messages; the buffered file
+ * sink writes the same text through a large stdio buffer; the binary sink
+ * stores fixed-size records; the null sink discards everything without
+ * even making a call.
+ */
+
+// Event types
+typedef enum {
+    REPORT_VOLTAGE_CHECK = 0,
+    REPORT_TEMPERATURE_CHECK = 1,
+    REPORT_CURRENT_CHECK = 2,
+    REPORT_REGISTER_WRITE = 3,        // address, value
+    REPORT_REGISTER_BATCH_WRITE = 4,  // address=first, aux=last, value=count
+    REPORT_REGISTER_CHECK = 5,        // label=name, address, value
+    REPORT_REGISTER_CHANGE = 6,       // label=name, aux=old value, value=new value
+    REPORT_CHIP_SCAN_BEGIN = 7,       // chip, value=priority
+    REPORT_CHIP_SCAN_END = 8          // chip, value=valid count, aux=register count
+} report_event_type_t;
+
+// Event outcomes
+typedef enum {
+    REPORT_PASS = 0,
+    REPORT_WARN = 1,
+    REPORT_FAIL = 2
+} report_outcome_t;
+
+// Event handed to a sink
+typedef struct {
+    uint16_t type;       // report_event_type_t
+    uint16_t outcome;    // report_outcome_t
+    int32_t chip;        // Chip id, or -1 if not chip-specific
+    uint32_t address;
+    uint32_t value;
+    uint32_t aux;
+    float reading;       // Sensor reading for *_CHECK sensor events
+    const char *label;   // Register name (not stored by the binary sink)
+} report_event_t;
+
+// On-disk record written by the binary sink
+typedef struct {
+    uint16_t type;
+    uint16_t outcome;
+    int32_t chip;
+    uint32_t address;
+    uint32_t value;
+    uint32_t aux;
+    float reading;
+} report_record_t;
+
+#define REPORT_BINARY_BUFFER_RECORDS 1024
+
+// Reporting sink
+typedef struct report_sink {
+    void (*emit)(struct report_sink *sink, const report_event_t *event);  // NULL discards
+    void (*flush)(struct report_sink *sink);
+    FILE *file;
+    char *text_buffer;                // stdio buffer of the buffered file sink
+    report_record_t *records;         // Pending records of the binary sink
+    size_t record_count;
+} report_sink_t;
+
+// Built-in sinks
+extern report_sink_t console_sink;
+extern report_sink_t null_sink;
+
+// Sink management
+void set_report_sink(report_sink_t *sink);
+report_sink_t *get_report_sink(void);
+bool open_file_sink(report_sink_t *sink, const char *path);
+bool open_binary_sink(report_sink_t *sink, const char *path);
+void close_report_sink(report_sink_t *sink);
+void format_report_event(FILE *out, const report_event_t *event);
+
+// Active sink (use set_report_sink() to change it)
+extern report_sink_t *active_report_sink;
+
+/**
+ * @brief Whether the active sink keeps events
+ *
+ * Lets callers skip building an event's label (a register name lookup)
+ * when the reports are discarded anyway.
+ */
+static inline bool report_sink_listening(void) {
+    return active_report_sink->emit != NULL;
+}
+
+/**
+ * @brief Hand an event to the active sink
+ */
+static inline void emit_report(const report_event_t *event) {
+    if (active_report_sink->emit != NULL) {
+        active_report_sink->emit(active_report_sink, event);
+    }
+}
+
+/**
+ * @brief Report a sensor validation result
+ */
+static inline void report_sensor(report_event_type_t type, report_outcome_t outcome,
+                                 float reading) {
+    if (active_report_sink->emit != NULL) {
+        report_event_t event = {(uint16_t)type, (uint16_t)outcome, -1, 0, 0, 0, reading, NULL};
+        active_report_sink->emit(active_report_sink, &event);
+    }
+}
+
+/**
+ * @brief Report a register-level event
+ */
+static inline void report_register(report_event_type_t type, report_outcome_t outcome,
+                                   int chip, const char *label, uint32_t address,
+                                   uint32_t value, uint32_t aux) {
+    if (active_report_sink->emit != NULL) {
+        report_event_t event = {(uint16_t)type, (uint16_t)outcome, chip, address, value, aux,
+                                0.0f, label};
+        active_report_sink->emit(active_report_sink, &event);
+    }
+}
+
+#endif // REPORT_SINK_H
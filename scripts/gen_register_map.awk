@@ -0,0 +1,247 @@
+# gen_register_map.awk - turn config/register_map.txt into a C header
+#
+# Usage: awk -f scripts/gen_register_map.awk config/register_map.txt > register_map.h
+#
+# Each non-comment line is either a register, "NAME ADDRESS MIN_VALUE
+# MAX_VALUE" with 32-bit hexadecimal numbers, or a bitfield of a register
+# defined above it, "FIELD REGISTER NAME MSB[:LSB] VALUES" where VALUES is
+# a decimal range "LOW-HIGH", a single value, or a set "A,B,C" (fields of
+# at most 5 bits). The header holds static const tables of the map and an
+# unrolled check against the compile-time bounds and fields.
+
+function is_hex32(text) {
+    return text ~ /^0[xX][0-9A-Fa-f]+$/ && length(text) <= 10
+}
+
+# Zero-padded upper-case digits, so that string order is numeric order
+function hex_key(text) {
+    text = toupper(substr(text, 3))
+    while (length(text) < 8) {
+        text = "0" text
+    }
+    return text
+}
+
+# 2^bits, exact in awk's doubles for bits <= 32
+function power_of_two(bits,    result) {
+    result = 1
+    while (bits-- > 0) {
+        result *= 2
+    }
+    return result
+}
+
+function parse_field(    bits, values, n, i, msb, lsb, width, low, high, set) {
+    if (!($2 in seen)) {
+        fail("field " $3 " refers to unknown register " $2)
+    }
+    if ($3 !~ /^[A-Za-z_][A-Za-z0-9_]*$/) {
+        fail("field name '" $3 "' is not a C identifier")
+    }
+    if (($2 SUBSEP $3) in seen_field) {
+        fail("field " $3 " of " $2 " defined twice")
+    }
+    if ($4 !~ /^[0-9]+(:[0-9]+)?$/) {
+        fail("field bits must be MSB or MSB:LSB")
+    }
+
+    n = split($4, bits, ":")
+    msb = bits[1] + 0
+    lsb = (n == 2) ? bits[2] + 0 : msb
+    width = msb - lsb + 1
+    if (msb > 31 || lsb > msb || width > 31) {
+        fail("field " $3 " must be 1 to 31 bits within bit 31")
+    }
+
+    set = ""
+    if ($5 ~ /^[0-9]+-[0-9]+$/) {
+        split($5, values, "-")
+        low = values[1] + 0
+        high = values[2] + 0
+    } else if ($5 ~ /^[0-9]+(,[0-9]+)*$/) {
+        n = split($5, values, ",")
+        low = high = values[1] + 0
+        for (i = 1; i <= n; i++) {
+            low = (values[i] + 0 < low) ? values[i] + 0 : low
+            high = (values[i] + 0 > high) ? values[i] + 0 : high
+            set = set ((i > 1) ? " | " : "") "(1u << " (values[i] + 0) ")"
+        }
+        if (n == 1) {
+            set = ""  # A single value is a one-value range
+        } else if (width > 5) {
+            fail("value sets are limited to fields of at most 5 bits")
+        }
+    } else {
+        fail("field values must be LOW-HIGH or A,B,C")
+    }
+    if (low > high || high >= power_of_two(width)) {
+        fail("values of field " $3 " do not fit in " width " bits")
+    }
+
+    seen_field[$2, $3] = 1
+    field_reg[field_count] = $2
+    field_name[field_count] = $3
+    field_shift[field_count] = lsb
+    field_width[field_count] = width
+    field_low[field_count] = low
+    field_high[field_count] = high
+    field_set[field_count] = set
+    field_count++
+}
+
+# C expression for field f of the register held in values[i]
+function field_check(f, i,    value) {
+    value = sprintf("((values[%d] >> %d) & ((1u << %d) - 1u))", i, field_shift[f], field_width[f])
+    if (field_set[f] != "") {
+        return sprintf("(((%s) >> %s) & 1u)", field_set[f], value)
+    }
+    if (field_low[f] == 0) {
+        return sprintf("(%s <= %du)", value, field_high[f])
+    }
+    return sprintf("((uint32_t)(%s - %du) <= %du)", value, field_low[f], field_high[f] - field_low[f])
+}
+
+function fail(message) {
+    printf("%s:%d: %s\n", FILENAME, FNR, message) > "/dev/stderr"
+    failed = 1
+    exit 1
+}
+
+BEGIN {
+    count = 0
+    field_count = 0
+    failed = 0
+}
+
+{
+    sub(/#.*/, "")
+    if (NF == 0) {
+        next
+    }
+    if ($1 == "FIELD") {
+        if (NF != 5) {
+            fail("expected FIELD REGISTER NAME MSB[:LSB] VALUES")
+        }
+        parse_field()
+        next
+    }
+    if (NF != 4) {
+        fail("expected NAME ADDRESS MIN_VALUE MAX_VALUE")
+    }
+    if ($1 !~ /^[A-Za-z_][A-Za-z0-9_]*$/) {
+        fail("register name '" $1 "' is not a C identifier")
+    }
+    if (!is_hex32($2) || !is_hex32($3) || !is_hex32($4)) {
+        fail("address and bounds must be 32-bit hexadecimal numbers")
+    }
+    if (hex_key($3) > hex_key($4)) {
+        fail("MIN_VALUE of " $1 " is above its MAX_VALUE")
+    }
+    if ($1 in seen) {
+        fail("register " $1 " defined twice")
+    }
+
+    seen[$1] = count
+    name[count] = $1
+    address[count] = $2 "u"
+    min[count] = $3 "u"
+    max[count] = $4 "u"
+    full_range[count] = (hex_key($3) == "00000000" && hex_key($4) == "FFFFFFFF")
+    count++
+}
+
+END {
+    if (failed) {
+        exit 1
+    }
+    if (count == 0 || count > 32) {
+        printf("%s: expected 1 to 32 registers, found %d\n", FILENAME, count) > "/dev/stderr"
+        exit 1
+    }
+
+    print "/* Generated from " FILENAME " by scripts/gen_register_map.awk - do not edit */"
+    print ""
+    print "#ifndef REGISTER_MAP_H"
+    print "#define REGISTER_MAP_H"
+    print ""
+    print "#include <stdint.h>"
+    print "#include \"monitor.h\""
+    print ""
+    printf("#define REGISTER_MAP_COUNT %d\n", count)
+    printf("#define REGISTER_MAP_FIELD_COUNT %d\n", field_count)
+    print ""
+    print "// Register indices"
+    for (i = 0; i < count; i++) {
+        printf("#define REGMAP_%s %d\n", name[i], i)
+    }
+    print ""
+
+    print "static const char *const register_map_names[REGISTER_MAP_COUNT] = {"
+    for (i = 0; i < count; i++) {
+        printf("    \"%s\",\n", name[i])
+    }
+    print "};"
+    print ""
+
+    print "static const uint32_t register_map_addresses[REGISTER_MAP_COUNT] = {"
+    for (i = 0; i < count; i++) {
+        printf("    %s,\n", address[i])
+    }
+    print "};"
+    print ""
+
+    print "static const uint32_t register_map_min[REGISTER_MAP_COUNT] = {"
+    for (i = 0; i < count; i++) {
+        printf("    %s,\n", min[i])
+    }
+    print "};"
+    print ""
+
+    print "static const uint32_t register_map_max[REGISTER_MAP_COUNT] = {"
+    for (i = 0; i < count; i++) {
+        printf("    %s,\n", max[i])
+    }
+    print "};"
+    print ""
+
+    print "// Bitfield specs, terminated by an entry with reg = -1"
+    print "static const register_field_spec_t register_map_fields[REGISTER_MAP_FIELD_COUNT + 1] = {"
+    for (f = 0; f < field_count; f++) {
+        printf("    {REGMAP_%s, \"%s\", %d, %d, %du, %du, %s},\n", field_reg[f], field_name[f],
+               field_shift[f], field_width[f], field_low[f], field_high[f],
+               (field_set[f] != "") ? field_set[f] : "0")
+    }
+    print "    {-1, 0, 0, 0, 0, 0, 0}"
+    print "};"
+    print ""
+
+    print "/**"
+    print " * @brief Check the map's registers against their compile-time bounds and fields"
+    print " * @param values REGISTER_MAP_COUNT values in map order"
+    print " * @return Bitmap with bit i set if values[i] is within its bounds and"
+    print " *         every field of register i holds an allowed value"
+    print " */"
+    print "static inline uint32_t register_map_validity(const uint32_t *values) {"
+    print "    uint32_t bits = 0;"
+    for (i = 0; i < count; i++) {
+        checks = ""
+        if (!full_range[i]) {
+            checks = sprintf("((uint32_t)(values[%d] - %s) <= %s - %s)", i, min[i], max[i], min[i])
+        }
+        for (f = 0; f < field_count; f++) {
+            if (seen[field_reg[f]] == i) {
+                checks = checks ((checks != "") ? "\n                       & " : "") field_check(f, i)
+            }
+        }
+
+        if (checks == "") {
+            printf("    bits |= 1u << %d;  // %s accepts every value\n", i, name[i])
+        } else {
+            printf("    bits |= (uint32_t)(%s) << %d;\n", checks, i)
+        }
+    }
+    print "    return bits;"
+    print "}"
+    print ""
+    print "#endif // REGISTER_MAP_H"
+}
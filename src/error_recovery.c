@@ -463,6 +463,7 @@ int main(void) {
     init_monitor_system(&system);
 
     if (!init_recovery_system(&system)) {
+        cleanup_monitor_system(&system);
         return -1;
     }
 
@@ -489,6 +490,7 @@ int main(void) {
     printf("\n=== Homework 2 Complete ===\n");
     printf("Error recovery systems successfully demonstrated!\n");
 
+    cleanup_monitor_system(&system);
     return 0;
 }
 
@@ -0,0 +1,327 @@
+/**
+ * @file monitor_bench.c
+ * @brief Micro-benchmarks for the monitor's hot paths
+ *
+ * Build and run with `make bench`. Branch misses are counted with
+ * perf_event_open() where the kernel allows it; otherwise only the
+ * elapsed times are shown.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "monitor.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/perf_event.h>)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define HAVE_PERF_EVENTS 1
+#endif
+#endif
+
+// Default number of readings per benchmark
+#define BENCH_DEFAULT_SAMPLES (1u << 20)
+
+// Keeps benchmarked results alive
+static volatile uint32_t bench_sink;
+
+/**
+ * @brief Hardware counter around one benchmark run
+ */
+typedef struct {
+    int fd;                 // Branch-miss counter, or -1 if unavailable
+    struct timespec start;
+    double seconds;
+    long long branch_misses;
+} bench_counter_t;
+
+/**
+ * @brief Open a branch-miss counter for the calling thread
+ * @return Counter descriptor, or -1 if perf events are unavailable
+ */
+static int open_branch_miss_counter(void) {
+#ifdef HAVE_PERF_EVENTS
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void bench_start(bench_counter_t *counter) {
+#ifdef HAVE_PERF_EVENTS
+    if (counter->fd >= 0) {
+        ioctl(counter->fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter->fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    clock_gettime(CLOCK_MONOTONIC, &counter->start);
+}
+
+static void bench_stop(bench_counter_t *counter) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    counter->seconds = (double)(end.tv_sec - counter->start.tv_sec) +
+                       (double)(end.tv_nsec - counter->start.tv_nsec) / 1e9;
+
+    counter->branch_misses = -1;
+#ifdef HAVE_PERF_EVENTS
+    if (counter->fd >= 0) {
+        long long misses = 0;
+        ioctl(counter->fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter->fd, &misses, sizeof(misses)) == (ssize_t)sizeof(misses)) {
+            counter->branch_misses = misses;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Print one result line
+ */
+static void bench_report(const char *name, const bench_counter_t *counter, size_t samples) {
+    printf("  %-28s %8.2f ns/reading", name, counter->seconds * 1e9 / (double)samples);
+    if (counter->branch_misses >= 0) {
+        printf("  %8.4f branch misses/reading",
+               (double)counter->branch_misses / (double)samples);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Uniform random float in [low, high)
+ */
+static float random_between(float low, float high) {
+    return low + (high - low) * ((float)rand() / ((float)RAND_MAX + 1.0f));
+}
+
+/**
+ * @brief Compare status classifiers on a noisy sensor trace
+ * @param samples Number of readings
+ *
+ * Temperatures hover around TEMP_WARNING and TEMP_CRITICAL and voltages
+ * around their limits, so the outcome of the if/else chain changes
+ * unpredictably from one reading to the next.
+ */
+static void bench_status_classifiers(size_t samples) {
+    printf("=== Status classification (%zu noisy readings) ===\n", samples);
+
+    float *voltage = malloc(samples * sizeof(float));
+    float *temperature = malloc(samples * sizeof(float));
+    float *current = malloc(samples * sizeof(float));
+    system_status_t *status = malloc(samples * sizeof(system_status_t));
+    if (voltage == NULL || temperature == NULL || current == NULL || status == NULL) {
+        printf("ERROR: Out of memory\n");
+        free(voltage);
+        free(temperature);
+        free(current);
+        free(status);
+        return;
+    }
+
+    srand(42);
+    for (size_t i = 0; i < samples; i++) {
+        float threshold = (rand() & 1) ? TEMP_WARNING : TEMP_CRITICAL;
+        temperature[i] = threshold + random_between(-2.0f, 2.0f);
+        voltage[i] = ((rand() & 7) == 0) ? MAX_VOLTAGE + random_between(-0.05f, 0.05f)
+                                         : random_between(MIN_VOLTAGE, MAX_VOLTAGE);
+        current[i] = random_between(MIN_CURRENT, MAX_CURRENT);
+    }
+    memset(status, 0, samples * sizeof(system_status_t));  // Fault the pages in up front
+
+    bench_counter_t counter = {open_branch_miss_counter(), {0, 0}, 0.0, -1};
+    if (counter.fd < 0) {
+        printf("  (branch-miss counter unavailable, timing only)\n");
+    }
+    uint32_t checksum[3] = {0, 0, 0};
+
+    // The reference classifier reports every check; discard the reports
+    set_report_sink(&null_sink);
+    bench_start(&counter);
+    for (size_t i = 0; i < samples; i++) {
+        checksum[0] += (uint32_t)determine_system_status(voltage[i], temperature[i], current[i]);
+    }
+    bench_stop(&counter);
+    set_report_sink(NULL);
+    bench_report("determine_system_status", &counter, samples);
+
+    bench_start(&counter);
+    for (size_t i = 0; i < samples; i++) {
+        checksum[1] += (uint32_t)classify_system_status(voltage[i], temperature[i], current[i]);
+    }
+    bench_stop(&counter);
+    bench_report("classify_system_status", &counter, samples);
+
+    bench_start(&counter);
+    determine_system_status_batch(voltage, temperature, current, samples, status);
+    bench_stop(&counter);
+    for (size_t i = 0; i < samples; i++) {
+        checksum[2] += (uint32_t)status[i];
+    }
+    bench_report("determine_system_status_batch", &counter, samples);
+
+    if (checksum[0] != checksum[1] || checksum[0] != checksum[2]) {
+        printf("  ERROR: Classifiers disagree (%u, %u, %u)\n",
+               checksum[0], checksum[1], checksum[2]);
+    }
+    bench_sink = checksum[1];
+
+    if (counter.fd >= 0) {
+        close(counter.fd);
+    }
+    free(voltage);
+    free(temperature);
+    free(current);
+    free(status);
+}
+
+/**
+ * @brief Scan and validation throughput for one register set size
+ * @param num_registers Registers in the set
+ * @param samples Total register reads across all passes
+ */
+static void bench_register_set(int num_registers, size_t samples) {
+    register_arena_t arena;
+    register_arena_init(&arena, 0);
+    monitor_system_t system;
+    init_monitor_system_in(&system, &arena);
+    if (!allocate_register_set(&system, &arena, num_registers)) {
+        printf("ERROR: Out of memory for %d registers\n", num_registers);
+        release_register_set(&system);
+        register_arena_reset(&arena);
+        return;
+    }
+    for (int i = 0; i < num_registers; i++) {
+        define_register(&system, i, REGISTER_FILE_BASE + 4u * (uint32_t)i,
+                        0x12345678, 0x12345678 + 0x80, "BENCH_REG");
+    }
+
+    size_t passes = samples / (size_t)num_registers;
+    passes = (passes > 0) ? passes : 1;
+    size_t registers = passes * (size_t)num_registers;
+    bench_counter_t counter = {-1, {0, 0}, 0.0, -1};
+    char name[48];
+    int valid = 0;
+
+    bench_start(&counter);
+    for (size_t pass = 0; pass < passes; pass++) {
+        read_system_registers_bulk(&system);
+    }
+    bench_stop(&counter);
+    snprintf(name, sizeof(name), "scan %d registers", num_registers);
+    bench_report(name, &counter, registers);
+
+    bench_start(&counter);
+    for (size_t pass = 0; pass < passes; pass++) {
+        valid += validate_system_registers(&system);
+    }
+    bench_stop(&counter);
+    snprintf(name, sizeof(name), "validate %d registers", num_registers);
+    bench_report(name, &counter, registers);
+
+    bench_sink = (uint32_t)valid;
+    release_register_set(&system);
+    register_arena_reset(&arena);
+}
+
+/**
+ * @brief Compare scan and validation throughput across register set sizes
+ * @param samples Total register reads per size
+ */
+static void bench_register_sets(size_t samples) {
+    static const int sizes[] = {16, 256, 4096};
+
+    printf("=== Register sets (%zu register reads per size) ===\n", samples);
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        bench_register_set(sizes[i], samples);
+    }
+}
+
+/**
+ * @brief Creation cost, memory footprint and full-scan time of one fleet size
+ * @param num_chips Chips in the fleet
+ * @param scheduler Task scheduler for the parallel scan
+ */
+static void bench_fleet(int num_chips, task_scheduler_t *scheduler) {
+    bench_counter_t counter = {-1, {0, 0}, 0.0, -1};
+
+    bench_start(&counter);
+    chip_fleet_t *fleet = create_chip_fleet(num_chips);
+    bench_stop(&counter);
+    if (fleet == NULL) {
+        printf("ERROR: Out of memory for %d chips\n", num_chips);
+        return;
+    }
+    double init_seconds = counter.seconds;
+    size_t footprint = chip_fleet_footprint(fleet);
+
+    set_report_sink(&null_sink);
+    bench_start(&counter);
+    int valid = scan_all_chips_registers(fleet);
+    bench_stop(&counter);
+    double scan_seconds = counter.seconds;
+
+    bench_start(&counter);
+    valid += scan_all_chips_registers_parallel(fleet, scheduler);
+    bench_stop(&counter);
+    set_report_sink(NULL);
+
+    printf("  %7d chips: init %9.3f ms, %10zu bytes (%5zu/chip), scan %9.3f ms (%7.1f ns/chip), "
+           "%d-thread scan %9.3f ms\n",
+           num_chips, init_seconds * 1e3, footprint, footprint / (size_t)num_chips,
+           scan_seconds * 1e3, scan_seconds * 1e9 / (double)num_chips,
+           task_scheduler_workers(scheduler), counter.seconds * 1e3);
+
+    bench_sink = (uint32_t)valid;
+    destroy_chip_fleet(fleet);
+}
+
+/**
+ * @brief Compare fleet creation, footprint and serial and parallel full scans across fleet sizes
+ */
+static void bench_fleets(void) {
+    static const int sizes[] = {8, 1000, 10000, 100000};
+
+    worker_pool_t *pool = create_worker_pool(0);
+    task_scheduler_t *scheduler = create_task_scheduler(pool);
+
+    printf("=== Chip fleets ===\n");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        bench_fleet(sizes[i], scheduler);
+    }
+    destroy_task_scheduler(scheduler);
+    destroy_worker_pool(pool);
+}
+
+/**
+ * @brief Run every benchmark
+ * @param argc Argument count
+ * @param argv argv[1] optionally overrides the number of samples
+ */
+int main(int argc, char *argv[]) {
+    size_t samples = BENCH_DEFAULT_SAMPLES;
+    if (argc > 1) {
+        samples = strtoul(argv[1], NULL, 0);
+        if (samples == 0) {
+            printf("Usage: %s [samples]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    bench_status_classifiers(samples);
+    bench_register_sets(samples);
+    bench_fleets();
+    return 0;
+}
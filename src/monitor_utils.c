@@ -13,12 +13,176 @@
 #include <unistd.h>
 #include <time.h>
 #include "monitor.h"
+#include "register_map.h"
+
+_Static_assert(REGISTER_MAP_COUNT <= MAX_REGISTERS, "register map must fit in a monitor system");
+
+// Registers in the test set installed by init_monitor_system()
+#define DEFAULT_REGISTER_COUNT 4
+
+// Alignment of each array within a register store block
+#define STORE_ARRAY_ALIGN 16
+
+// Minimum heap block of a system's name index arena (the index is a few small tables)
+#define NAME_INDEX_ARENA_BLOCK 256u
+
+// Slowly changing control registers whose reads are served from the shadow
+static const char *shadow_cached_names[] = {"CTRL_REG", "CONFIG_REG", "MODE_REG"};
+
+/**
+ * @brief Empty a system's shadow cache and mark its control registers cacheable
+ */
+static void reset_shadow_cache(monitor_system_t *system) {
+    size_t words = REGISTER_BITMAP_WORDS(system->num_registers);
+    size_t num_cached = sizeof(shadow_cached_names) / sizeof(shadow_cached_names[0]);
+    register_symbol_t cached[sizeof(shadow_cached_names) / sizeof(shadow_cached_names[0])];
+
+    for (size_t n = 0; n < num_cached; n++) {
+        cached[n] = intern_register_name(shadow_cached_names[n]);
+    }
+
+    memset(system->shadow_valid, 0, words * sizeof(uint64_t));
+    memset(system->shadow_dirty, 0, words * sizeof(uint64_t));
+    memset(system->shadow_cached, 0, words * sizeof(uint64_t));
+    for (int i = 0; i < system->num_registers; i++) {
+        system->shadow_values[i] = 0;
+        for (size_t n = 0; n < num_cached; n++) {
+            if (system->name_ids[i] == cached[n]) {
+                set_register_bit(system->shadow_cached, i);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Size a system's register store
+ * @param system Pointer to monitor system structure
+ * @param arena Arena to allocate from (NULL for a store owned by the system)
+ * @param num_registers Number of registers, 1 to MAX_REGISTERS
+ * @return true if the store was allocated, false on invalid arguments or out of memory
+ *
+ * The new registers have no name, address, bounds, bitfield rules or
+ * value and are marked invalid; the shadow cache starts empty. The
+ * previous store and name index are not released (see
+ * release_register_set()); an arena store is released with its arena.
+ */
+bool allocate_register_set(monitor_system_t *system, register_arena_t *arena, int num_registers) {
+    if (system == NULL || num_registers <= 0 || num_registers > MAX_REGISTERS) {
+        return false;
+    }
+
+    size_t n = (size_t)num_registers;
+    size_t words = REGISTER_BITMAP_WORDS(n);
+
+    // One block per store, hot arrays first and names last. Small sets
+    // (a few registers per chip) share lines instead of padding every
+    // array to its own; with a multiple of 16 registers the values,
+    // bounds, addresses and validity bitmap still start on cache lines.
+    size_t array_bytes = (n * sizeof(uint32_t) + STORE_ARRAY_ALIGN - 1) & ~(size_t)(STORE_ARRAY_ALIGN - 1);
+    size_t mask_bytes = (words * sizeof(uint64_t) + STORE_ARRAY_ALIGN - 1) & ~(size_t)(STORE_ARRAY_ALIGN - 1);
+    size_t block_bytes = 9 * array_bytes + 4 * mask_bytes;
+    unsigned char *block;
+    if (arena != NULL) {
+        block = register_arena_alloc(arena, block_bytes);
+    } else {
+        size_t rounded = (block_bytes + REGISTER_ARENA_ALIGN - 1) & ~(size_t)(REGISTER_ARENA_ALIGN - 1);
+        block = aligned_alloc(REGISTER_ARENA_ALIGN, rounded);
+        if (block != NULL) {
+            memset(block, 0, rounded);
+        }
+    }
+    if (block == NULL) {
+        return false;
+    }
+
+    register_store_t regs = {
+        (uint32_t *)block,
+        (uint32_t *)(block + array_bytes),
+        (uint32_t *)(block + 2 * array_bytes),
+        (uint32_t *)(block + 3 * array_bytes),
+        (uint64_t *)(block + 4 * array_bytes),
+        (uint32_t *)(block + 4 * array_bytes + 4 * mask_bytes),
+        num_registers
+    };
+    uint64_t *shadow_masks = (uint64_t *)(block + 4 * array_bytes + mask_bytes);
+    uint32_t *shadow_values = (uint32_t *)(block + 7 * array_bytes + 4 * mask_bytes);
+    register_symbol_t *names = (register_symbol_t *)(block + 8 * array_bytes + 4 * mask_bytes);
+
+    system->arena = arena;
+    system->owned_store = (arena == NULL) ? block : NULL;
+    system->num_registers = num_registers;
+    system->regs = regs;
+    system->shadow_values = shadow_values;
+    system->shadow_valid = shadow_masks;
+    system->shadow_dirty = shadow_masks + words;
+    system->shadow_cached = shadow_masks + 2 * words;
+    system->name_ids = names;
+    system->name_index_stale = true;
+    register_arena_init(&system->name_index_arena, NAME_INDEX_ARENA_BLOCK);
+    system->field_checks = NULL;
+    return true;
+}
+
+/**
+ * @brief Release a system's register store and name index
+ * @param system Pointer to monitor system structure
+ *
+ * A store owned by the system is freed; a store taken from a shared
+ * arena stays in the arena until it is reset. The system is left with
+ * no registers.
+ */
+void release_register_set(monitor_system_t *system) {
+    if (system == NULL) {
+        return;
+    }
+
+    free(system->owned_store);
+    system->owned_store = NULL;
+    register_arena_reset(&system->name_index_arena);
+    system->name_index_stale = true;
+    system->num_registers = 0;
+    system->regs = (register_store_t){NULL, NULL, NULL, NULL, NULL, NULL, 0};
+}
+
+/**
+ * @brief Describe one register of a system's register store
+ * @param system Pointer to monitor system structure
+ * @param index Register index within the system
+ * @param address Register address
+ * @param min Inclusive lower bound of valid values
+ * @param max Inclusive upper bound of valid values
+ * @param name Register name
+ */
+void define_register(monitor_system_t *system, int index, uint32_t address,
+                     uint32_t min, uint32_t max, const char *name) {
+    if (system == NULL || index < 0 || index >= system->num_registers) {
+        return;
+    }
+
+    system->regs.addresses[index] = address;
+    system->regs.min[index] = min;
+    system->regs.max[index] = max;
+    set_register_name(system, index, name);
+}
 
 /**
  * @brief Initialize monitor system with default values
  * @param system Pointer to monitor system structure
  */
 void init_monitor_system(monitor_system_t *system) {
+    init_monitor_system_in(system, NULL);
+}
+
+/**
+ * @brief Initialize a monitor system with its register store in a given arena
+ * @param system Pointer to monitor system structure
+ * @param arena Arena holding the register store (NULL for a store owned by
+ *              the system, freed by cleanup_monitor_system())
+ *
+ * Systems that are created and discarded together (a fleet of chips)
+ * share one arena and are released by resetting it.
+ */
+void init_monitor_system_in(monitor_system_t *system, register_arena_t *arena) {
     if (system == NULL) {
         return;
     }
@@ -30,21 +194,144 @@ void init_monitor_system(monitor_system_t *system) {
     system->status = STATUS_NORMAL;
     system->error_count = 0;
     system->system_active = true;
-    system->num_registers = 4; // Initialize with 4 test registers
+    system->transport = get_register_transport();
+    system->sim_sequence = 0;
+    system->name_chip = -1;
+    system->num_registers = 0;
+    if (!allocate_register_set(system, arena, DEFAULT_REGISTER_COUNT)) {
+        printf("ERROR: Out of memory for %d registers\n", DEFAULT_REGISTER_COUNT);
+        return;
+    }
 
     // Initialize test registers
     const char* reg_names[] = {"CTRL_REG", "STATUS_REG", "DATA_REG", "CONFIG_REG"};
     uint32_t base_addr = 0x40000000;
 
     for (int i = 0; i < system->num_registers; i++) {
-        system->registers[i].address = base_addr + (i * 4);
-        system->registers[i].value = 0x12345678 + i;
-        system->registers[i].expected_min = 0x10000000;
-        system->registers[i].expected_max = 0x20000000;
-        system->registers[i].is_valid = true;
-        strncpy(system->registers[i].name, reg_names[i], sizeof(system->registers[i].name) - 1);
-        system->registers[i].name[sizeof(system->registers[i].name) - 1] = '\0';
+        define_register(system, i, base_addr + (i * 4), 0x10000000, 0x20000000, reg_names[i]);
+        system->regs.values[i] = 0x12345678 + i;
+        set_register_valid(system, i, true);
+    }
+
+    reset_shadow_cache(system);
+}
+
+/**
+ * @brief Copy one register out of a system's register store
+ * @param system Pointer to monitor system structure
+ * @param index Register index within the system
+ * @param info Receives the register's fields
+ * @return true if the register exists
+ */
+bool get_register_info(const monitor_system_t *system, int index, register_info_t *info) {
+    if (system == NULL || info == NULL || index < 0 || index >= system->num_registers) {
+        return false;
+    }
+
+    info->address = register_address(system, index);
+    info->value = register_value(system, index);
+    info->expected_min = register_min(system, index);
+    info->expected_max = register_max(system, index);
+    info->is_valid = register_is_valid(system, index);
+    strncpy(info->name, register_name(system, index), sizeof(info->name) - 1);
+    info->name[sizeof(info->name) - 1] = '\0';
+    return true;
+}
+
+/**
+ * @brief Store one register into a system's register store
+ * @param system Pointer to monitor system structure
+ * @param index Register index within the system
+ * @param info Register fields to store
+ * @return true if the register exists
+ */
+bool set_register_info(monitor_system_t *system, int index, const register_info_t *info) {
+    if (system == NULL || info == NULL || index < 0 || index >= system->num_registers) {
+        return false;
+    }
+
+    define_register(system, index, info->address, info->expected_min, info->expected_max,
+                    info->name);
+    set_register_value(system, index, info->value);
+    set_register_valid(system, index, info->is_valid);
+    return true;
+}
+
+/**
+ * @brief Rename a register
+ * @param system Pointer to monitor system structure
+ * @param index Register index within the system
+ * @param name New name (truncated to REGISTER_NAME_LENGTH - 1 characters)
+ */
+void set_register_name(monitor_system_t *system, int index, const char *name) {
+    if (system == NULL || name == NULL || index < 0 || index >= system->num_registers) {
+        return;
+    }
+
+    register_symbol_t symbol = intern_register_name(name);
+    system->name_ids[index] = (symbol != REGISTER_SYMBOL_NONE) ? symbol : REGISTER_SYMBOL_EMPTY;
+    system->name_index_stale = true;
+}
+
+/**
+ * @brief Bitfield rules of the register map, compiled on first use
+ * @return Compiled rules, or NULL if they could not be compiled
+ */
+static const register_field_checks_t *register_map_field_checks(void) {
+    static register_field_checks_t checks;
+    static bool compiled = false;
+
+    if (!compiled) {
+        compiled = compile_register_fields(&checks, default_register_arena(), register_map_fields,
+                                           REGISTER_MAP_FIELD_COUNT, REGISTER_MAP_COUNT);
+    }
+    return compiled ? &checks : NULL;
+}
+
+/**
+ * @brief Replace a system's registers with the full register map
+ * @param system Pointer to an initialized monitor system
+ * @return Number of registers loaded, or -1 if system is NULL or out of memory
+ *
+ * Names, addresses, bounds and bitfield rules come from the tables
+ * generated from config/register_map.txt; register values start at zero. The store is
+ * resized to the map from the arena the system was initialized with.
+ */
+int load_register_map(monitor_system_t *system) {
+    if (system == NULL) {
+        return -1;
+    }
+
+    monitor_system_t previous = *system;
+    if (!allocate_register_set(system, system->arena, REGISTER_MAP_COUNT)) {
+        return -1;
+    }
+    release_register_set(&previous);
+    for (int i = 0; i < REGISTER_MAP_COUNT; i++) {
+        define_register(system, i, register_map_addresses[i], register_map_min[i],
+                        register_map_max[i], register_map_names[i]);
+        set_register_valid(system, i, true);
+    }
+    system->field_checks = register_map_field_checks();
+
+    reset_shadow_cache(system);
+    return system->num_registers;
+}
+
+/**
+ * @brief Seed a system's simulated device state
+ * @param system Pointer to monitor system structure
+ * @param seed Starting point of the system's simulated read sequence
+ *
+ * Systems with the same seed see the same simulated register values,
+ * independent of which thread reads them or in what order.
+ */
+void seed_monitor_system(monitor_system_t *system, uint32_t seed) {
+    if (system == NULL) {
+        return;
     }
+
+    system->sim_sequence = seed;
 }
 
 /**
@@ -57,36 +344,283 @@ void cleanup_monitor_system(monitor_system_t *system) {
     }
 
     system->system_active = false;
+    release_register_set(system);
     printf("Monitor system cleaned up\n");
 }
 
 /**
- * @brief Simulate reading from a hardware register
+ * @brief Read a hardware register through the default transport
  * @param address Register address
- * @return Simulated register value
+ * @return Register value
  */
 uint32_t read_register(uint32_t address) {
-    // Simulate register read with some variation
-    static uint32_t counter = 0;
-    counter++;
+    return transport_read(get_register_transport(), address);
+}
+
+/**
+ * @brief Read a set of hardware registers in one call
+ * @param addrs Array of register addresses
+ * @param out Array receiving one value per address
+ * @param n Number of registers to read
+ * @return Number of registers read
+ *
+ * Produces the same values as n consecutive read_register() calls, but
+ * pays the per-access overhead once for the whole set.
+ */
+size_t read_registers_bulk(const uint32_t *addrs, uint32_t *out, size_t n) {
+    if (addrs == NULL || out == NULL) {
+        return 0;
+    }
+
+    return transport_read_bulk(get_register_transport(), addrs, out, n);
+}
+
+/**
+ * @brief Check whether a register's reads are served from its shadow
+ *
+ * Matches shadow_read_register(): a cached register with a valid shadow,
+ * or any register with a pending write.
+ */
+static bool served_from_shadow(const monitor_system_t *system, int index) {
+    return register_bit(system->shadow_valid, index) &&
+           (register_bit(system->shadow_cached, index) || register_bit(system->shadow_dirty, index));
+}
+
+/**
+ * @brief Collect the registers that must be read from hardware
+ * @param system Pointer to monitor system structure
+ * @param addrs Receives the addresses to transfer
+ * @return Number of registers to transfer
+ *
+ * Registers served from the shadow (cached with a valid shadow, or with
+ * a pending write) are filled in right away and left out of the transfer.
+ */
+static int gather_hardware_registers(monitor_system_t *system, uint32_t *addrs) {
+    int pending = 0;
+
+    for (int i = 0; i < system->num_registers; i++) {
+        if (served_from_shadow(system, i)) {
+            system->regs.values[i] = system->shadow_values[i];
+        } else {
+            addrs[pending++] = system->regs.addresses[i];
+        }
+    }
+    return pending;
+}
+
+/**
+ * @brief Store transferred values in the registers and their shadows
+ *
+ * values holds one entry per register left out of the shadow by
+ * gather_hardware_registers(), in register order.
+ */
+static void commit_hardware_values(monitor_system_t *system, const uint32_t *values) {
+    int p = 0;
+
+    for (int i = 0; i < system->num_registers; i++) {
+        if (served_from_shadow(system, i)) {
+            continue;
+        }
+        system->regs.values[i] = values[p];
+        if (register_bit(system->shadow_cached, i)) {
+            system->shadow_values[i] = values[p];
+            set_register_bit(system->shadow_valid, i);
+        }
+        p++;
+    }
+}
+
+/**
+ * @brief Refresh every register of a monitor system with one bulk read
+ * @param system Pointer to monitor system structure
+ * @return Number of registers refreshed, or -1 if system is NULL
+ *
+ * Cached registers whose shadow is valid, and registers with a pending
+ * write, are served from the shadow and left out of the hardware transfer.
+ */
+int read_system_registers_bulk(monitor_system_t *system) {
+    if (system == NULL) {
+        return -1;
+    }
+
+    uint32_t *addrs = system->regs.scratch;
+    uint32_t *values = addrs + system->regs.capacity;
+    int pending = gather_hardware_registers(system, addrs);
+
+    uint32_t thread_sequence = simulated_swap_sequence(system->sim_sequence);
+    transport_read_bulk(system->transport, addrs, values, (size_t)pending);
+    system->sim_sequence = simulated_swap_sequence(thread_sequence);
+
+    commit_hardware_values(system, values);
+    return system->num_registers;
+}
+
+/**
+ * @brief Refresh a system's registers, rejecting corrupted transfers
+ * @param system Pointer to monitor system
+ * @param max_retries Number of times a corrupted block is read again
+ * @return ERROR_NONE, or ERROR_INVALID_DATA if every attempt was corrupted
+ *
+ * The hardware block is read twice per attempt and accepted only when
+ * both copies are identical; a mismatch re-reads the whole block.
+ * Register values are left untouched if no attempt succeeds.
+ *
+ * This guards against transfers corrupted in transit (a flipped bit or a
+ * torn bulk read) that make two reads of the same device state disagree.
+ * It does not catch corruption that repeats identically on both reads.
+ * The simulated device is rewound between the two reads, so there the
+ * copies only differ when a wrapping transport injects faults.
+ *
+ * While recording, both reads go to the recorded transport and only the
+ * accepted block is traced. A replayed block comes from the trace file,
+ * not a bus, so it is read once and accepted.
+ */
+error_code_t read_system_registers_checked(monitor_system_t *system, int max_retries) {
+    if (system == NULL) {
+        return ERROR_INVALID_DATA;
+    }
+
+    uint32_t *addrs = system->regs.scratch;
+    uint32_t *values = addrs + system->regs.capacity;
+    uint32_t *second = values + system->regs.capacity;
+    size_t n = (size_t)gather_hardware_registers(system, addrs);
+    const register_transport_t *transport = traced_register_transport(system->transport);
+
+    if (transport == &replay_transport) {
+        if (transport_read_bulk(transport, addrs, values, n) != n) {
+            return ERROR_INVALID_DATA;
+        }
+        commit_hardware_values(system, values);
+        return ERROR_NONE;
+    }
+
+    for (int attempt = 0; attempt <= max_retries; attempt++) {
+        // The simulated device holds its state across both reads of an attempt
+        uint32_t start = system->sim_sequence;
+        uint32_t thread_sequence = simulated_swap_sequence(start);
+        size_t done = transport_read_bulk(transport, addrs, values, n);
+        simulated_swap_sequence(start);
+        done += transport_read_bulk(transport, addrs, second, n);
+        system->sim_sequence = simulated_swap_sequence(thread_sequence);
+
+        if (done == 2 * n && memcmp(values, second, n * sizeof(uint32_t)) == 0) {
+            if (transport != system->transport) {
+                record_register_reads(addrs, values, n);
+            }
+            commit_hardware_values(system, values);
+            return ERROR_NONE;
+        }
+    }
+
+    return ERROR_INVALID_DATA;
+}
+
+/**
+ * @brief Write a set of hardware registers in one batch
+ * @param addrs Array of register addresses
+ * @param values Array of values, one per address
+ * @param n Number of registers to write
+ * @return Number of registers written
+ */
+size_t write_registers_bulk(const uint32_t *addrs, const uint32_t *values, size_t n) {
+    if (addrs == NULL || values == NULL || n == 0) {
+        return 0;
+    }
+
+    return transport_write_bulk(get_register_transport(), addrs, values, n);
+}
+
+/**
+ * @brief Read a register through the shadow cache
+ * @param system Pointer to monitor system structure
+ * @param index Register index within the system
+ * @return Register value (0 if system or index is invalid)
+ *
+ * Cached registers are read from hardware only while their shadow is
+ * empty; pending writes are always visible to subsequent reads.
+ */
+uint32_t shadow_read_register(monitor_system_t *system, int index) {
+    if (system == NULL || index < 0 || index >= system->num_registers) {
+        return 0;
+    }
+
+    bool cached = register_bit(system->shadow_cached, index);
+    if (register_bit(system->shadow_valid, index) &&
+        (cached || register_bit(system->shadow_dirty, index))) {
+        return system->shadow_values[index];
+    }
 
-    // Base value with some variation
-    uint32_t base_value = 0x12345678;
-    uint32_t variation = (counter % 16) << 4;
+    uint32_t thread_sequence = simulated_swap_sequence(system->sim_sequence);
+    uint32_t value = transport_read(system->transport, register_address(system, index));
+    system->sim_sequence = simulated_swap_sequence(thread_sequence);
+    if (cached) {
+        system->shadow_values[index] = value;
+        set_register_bit(system->shadow_valid, index);
+    }
+    return value;
+}
+
+/**
+ * @brief Stage a register write in the shadow cache
+ * @param system Pointer to monitor system structure
+ * @param index Register index within the system
+ * @param value Value to write
+ * @return true if the write was staged, false if system or index is invalid
+ *
+ * Repeated writes to the same register coalesce into one pending write;
+ * nothing reaches hardware until flush_shadow_registers() is called.
+ */
+bool shadow_write_register(monitor_system_t *system, int index, uint32_t value) {
+    if (system == NULL || index < 0 || index >= system->num_registers) {
+        return false;
+    }
+
+    system->shadow_values[index] = value;
+    set_register_bit(system->shadow_valid, index);
+    set_register_bit(system->shadow_dirty, index);
+    return true;
+}
 
-    return base_value + variation;
+/**
+ * @brief Push every dirty shadow register to hardware in one batch
+ * @param system Pointer to monitor system structure
+ * @return Number of registers written, or -1 if system is NULL
+ */
+int flush_shadow_registers(monitor_system_t *system) {
+    if (system == NULL) {
+        return -1;
+    }
+
+    uint32_t *addrs = system->regs.scratch;
+    uint32_t *values = addrs + system->regs.capacity;
+    int count = 0;
+
+    for (int i = 0; i < system->num_registers; i++) {
+        if (register_bit(system->shadow_dirty, i)) {
+            addrs[count] = system->regs.addresses[i];
+            values[count] = system->shadow_values[i];
+            count++;
+        }
+    }
+
+    transport_write_bulk(system->transport, addrs, values, (size_t)count);
+
+    // Only cached registers keep a valid shadow once the write is out
+    for (size_t w = 0; w < REGISTER_BITMAP_WORDS(system->num_registers); w++) {
+        system->shadow_dirty[w] = 0;
+        system->shadow_valid[w] &= system->shadow_cached[w];
+    }
+    return count;
 }
 
 /**
- * @brief Simulate writing to a hardware register
+ * @brief Write a hardware register through the default transport
  * @param address Register address
  * @param value Value to write
  * @return true if write successful, false otherwise
  */
 bool write_register(uint32_t address, uint32_t value) {
-    // Simulate register write
-    printf("Writing 0x%08X to register 0x%08X\n", value, address);
-    return true;
+    return transport_write(get_register_transport(), address, value);
 }
 
 /**
@@ -118,9 +652,9 @@ void print_system_state(const monitor_system_t *system) {
 
     for (int i = 0; i < system->num_registers; i++) {
         printf("  %s: 0x%08X (%s)\n",
-               system->registers[i].name,
-               system->registers[i].value,
-               system->registers[i].is_valid ? "VALID" : "INVALID");
+               register_name(system, i),
+               register_value(system, i),
+               register_is_valid(system, i) ? "VALID" : "INVALID");
     }
     printf("==================\n");
 }
@@ -149,13 +683,13 @@ void debug_register_dump(const monitor_system_t *system) {
 
     printf("=== Register Dump ===\n");
     for (int i = 0; i < system->num_registers; i++) {
-        printf("Register %d (%s):\n", i, system->registers[i].name);
-        printf("  Address: 0x%08X\n", system->registers[i].address);
-        printf("  Value: 0x%08X\n", system->registers[i].value);
+        printf("Register %d (%s):\n", i, register_name(system, i));
+        printf("  Address: 0x%08X\n", register_address(system, i));
+        printf("  Value: 0x%08X\n", register_value(system, i));
         printf("  Range: [0x%08X, 0x%08X]\n",
-               system->registers[i].expected_min,
-               system->registers[i].expected_max);
-        printf("  Valid: %s\n", system->registers[i].is_valid ? "YES" : "NO");
+               register_min(system, i),
+               register_max(system, i));
+        printf("  Valid: %s\n", register_is_valid(system, i) ? "YES" : "NO");
     }
     printf("====================\n");
 }
@@ -211,10 +745,11 @@ void emergency_shutdown(monitor_system_t *system) {
     system->system_active = false;
     system->status = STATUS_CRITICAL;
 
-    // Simulate shutdown sequence
+    // Simulate shutdown sequence: stage every register, then flush once
     for (int i = 0; i < system->num_registers; i++) {
-        write_register(system->registers[i].address, 0x00000000);
+        shadow_write_register(system, i, 0x00000000);
     }
+    flush_shadow_registers(system);
 
     printf("Emergency shutdown complete\n");
 }
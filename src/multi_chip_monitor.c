@@ -18,116 +18,270 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <limits.h>
+#include <stdatomic.h>
 #define _POSIX_C_SOURCE 200809L
 #include <unistd.h>
 #include "../include/monitor.h"
 
 // Multi-chip system constants
-#define MAX_CHIPS 8
 #define MAX_REGISTERS_PER_CHIP 16
 #define CHIP_SCAN_INTERVAL 100  // milliseconds
+#define FLEET_ARENA_BLOCK (1u << 20)  // Arena block size of a fleet
+#define FLEET_POLL_DEPTH 256u         // Most chips read asynchronously at once
 
 /**
- * @brief Multi-chip system structure
+ * @brief Create a fleet of chips
+ * @param num_chips Number of chips, 1 to MAX_FLEET_CHIPS
+ * @return New fleet, or NULL on an invalid count or out of memory
+ *
+ * The chip records are one contiguous, cache-line aligned array; they,
+ * every chip's register store and the fleet address index come from the
+ * fleet's own arena, so creating and destroying a fleet costs a handful
+ * of heap allocations regardless of its size. Chip i's registers sit
+ * i * CHIP_ADDRESS_STRIDE above the default register addresses; an
+ * attached register file is grown to cover every chip.
  */
-typedef struct {
-    int chip_id;
-    bool is_active;
-    monitor_system_t monitor;
-    int priority_level;  // 1=high, 2=medium, 3=low
-} chip_system_t;
+chip_fleet_t *create_chip_fleet(int num_chips) {
+    if (num_chips <= 0 || num_chips > MAX_FLEET_CHIPS) {
+        return NULL;
+    }
+
+    chip_fleet_t *fleet = malloc(sizeof(chip_fleet_t));
+    if (fleet == NULL) {
+        return NULL;
+    }
+    register_arena_init(&fleet->arena, FLEET_ARENA_BLOCK);
+    fleet->num_chips = num_chips;
+    fleet->active_chip_count = num_chips;
+    fleet->chips = register_arena_alloc(&fleet->arena, (size_t)num_chips * sizeof(chip_system_t));
+
+    // Every chip starts active; bits past the last chip stay clear
+    size_t active_words = REGISTER_BITMAP_WORDS(num_chips);
+    fleet->active = register_arena_alloc(&fleet->arena, active_words * sizeof(uint64_t));
+    if (fleet->active != NULL) {
+        memset(fleet->active, 0xFF, active_words * sizeof(uint64_t));
+        if (num_chips % 64 != 0) {
+            fleet->active[active_words - 1] = (1ull << (num_chips % 64)) - 1;
+        }
+    }
+
+    const monitor_system_t **monitors = malloc((size_t)num_chips * sizeof(monitor_system_t *));
+    bool created = (fleet->chips != NULL && fleet->active != NULL && monitors != NULL);
+
+    for (int chip = 0; chip < num_chips && created; chip++) {
+        chip_system_t *record = &fleet->chips[chip];
+        record->chip_id = chip;
+        record->priority_level = (chip % 3) + 1; // Distribute priorities
+        record->sample_period = (uint32_t)record->priority_level;
+
+        init_monitor_system_in(&record->monitor, &fleet->arena);
+        created = (record->monitor.num_registers > 0);
+        seed_monitor_system(&record->monitor, (uint32_t)chip);
+
+        // Modify register addresses to be chip-specific
+        for (int reg = 0; reg < record->monitor.num_registers; reg++) {
+            record->monitor.regs.addresses[reg] += (uint32_t)chip * CHIP_ADDRESS_STRIDE;
+        }
+
+        // Chip-specific names ("CHIP<n>_<register>") are derived when first reported
+        record->monitor.name_chip = chip;
+        monitors[chip] = &record->monitor;
+    }
+
+    // A file-backed fleet must not read its upper chips from the simulator
+    uint32_t end = 0;
+    for (int chip = 0; chip < num_chips && created; chip++) {
+        const monitor_system_t *monitor = &fleet->chips[chip].monitor;
+        for (int reg = 0; reg < monitor->num_registers; reg++) {
+            uint32_t past = monitor->regs.addresses[reg] + (uint32_t)sizeof(uint32_t);
+            end = (past > end) ? past : end;
+        }
+    }
+    if (created && !reserve_register_file(end)) {
+        printf("WARNING: Register file could not grow to cover %d chips\n", num_chips);
+    }
+
+    // Index every chip's register addresses for constant-time updates
+    created = created && build_register_address_index(&fleet->address_index, &fleet->arena,
+                                                      monitors, num_chips);
+    free(monitors);
+    if (!created) {
+        destroy_chip_fleet(fleet);
+        return NULL;
+    }
+    return fleet;
+}
 
 /**
- * @brief Multi-chip monitoring array
+ * @brief Release a fleet and every chip's register store
+ * @param fleet Fleet from create_chip_fleet() (NULL is ignored)
  */
-static chip_system_t chip_systems[MAX_CHIPS];
-static int active_chip_count = 0;
+void destroy_chip_fleet(chip_fleet_t *fleet) {
+    if (fleet == NULL) {
+        return;
+    }
+
+    // Name indexes live outside the fleet arena
+    for (int chip = 0; fleet->chips != NULL && chip < fleet->num_chips; chip++) {
+        release_register_set(&fleet->chips[chip].monitor);
+    }
+    register_arena_reset(&fleet->arena);
+    free(fleet);
+}
 
 /**
- * @brief Initialize multi-chip monitoring system
- * @param num_chips Number of chips to monitor
- * @return true if initialization successful, false otherwise
+ * @brief Memory held by a fleet
+ * @param fleet Fleet to measure
+ * @return Bytes of the fleet object, chip records, register stores and address index
  */
-bool init_multi_chip_system(int num_chips) {
-    if (num_chips <= 0 || num_chips > MAX_CHIPS) {
-        printf("ERROR: Invalid number of chips (%d). Must be 1-%d\n", num_chips, MAX_CHIPS);
-        return false;
+size_t chip_fleet_footprint(const chip_fleet_t *fleet) {
+    if (fleet == NULL) {
+        return 0;
     }
 
-    printf("Initializing multi-chip monitoring system with %d chips...\n", num_chips);
+    return sizeof(chip_fleet_t) + fleet->arena.used;
+}
 
-    // Initialize each chip system using nested loops
-    for (int chip = 0; chip < num_chips; chip++) {
-        chip_systems[chip].chip_id = chip;
-        chip_systems[chip].is_active = true;
-        chip_systems[chip].priority_level = (chip % 3) + 1; // Distribute priorities
+/**
+ * @brief Next active chip in chip order
+ * @param fleet Fleet to walk
+ * @param chip Chip to continue after (-1 to start at the first chip)
+ * @return Lowest active chip above chip, or -1 if there is none
+ *
+ * One count-trailing-zeros per active chip plus one load per 64
+ * inactive chips. The bitmap is read as it is now, so chips deactivated
+ * during a walk are not visited later in it.
+ */
+int next_active_chip(const chip_fleet_t *fleet, int chip) {
+    if (fleet == NULL || chip < -1 || chip + 1 >= fleet->num_chips) {
+        return -1;
+    }
 
-        // Initialize monitor system for each chip
-        init_monitor_system(&chip_systems[chip].monitor);
+    int next = chip + 1;
+    size_t word = (size_t)next >> 6;
+    size_t words = REGISTER_BITMAP_WORDS(fleet->num_chips);
+    uint64_t bits = fleet->active[word] & (~0ull << (next & 63));
+    while (bits == 0) {
+        if (++word == words) {
+            return -1;
+        }
+        bits = fleet->active[word];
+    }
+    return (int)(word * 64 + (size_t)__builtin_ctzll(bits));
+}
 
-        // Customize each chip's register configuration
-        for (int reg = 0; reg < chip_systems[chip].monitor.num_registers; reg++) {
-            // Modify register addresses to be chip-specific
-            chip_systems[chip].monitor.registers[reg].address += (chip * 0x1000);
+/**
+ * @brief Stop monitoring a chip
+ * @param fleet Fleet owning the chip
+ * @param chip Chip to deactivate
+ * @return true if the chip was active
+ *
+ * Constant time; safe while the fleet is being walked with next_active_chip().
+ */
+bool deactivate_chip(chip_fleet_t *fleet, int chip) {
+    if (fleet == NULL || !chip_is_active(fleet, chip)) {
+        return false;
+    }
 
-            // Set chip-specific names
-            snprintf(chip_systems[chip].monitor.registers[reg].name,
-                    sizeof(chip_systems[chip].monitor.registers[reg].name),
-                    "CHIP%d_REG%d", chip, reg);
-        }
+    clear_register_bit(fleet->active, chip);
+    fleet->active_chip_count--;
+    return true;
+}
+
+/**
+ * @brief Dense list of the active chips
+ * @param fleet Fleet to list
+ * @param chips Receives the active chips in chip order (room for active_chip_count)
+ * @return Number of chips written
+ */
+int list_active_chips(const chip_fleet_t *fleet, int *chips) {
+    if (fleet == NULL || chips == NULL) {
+        return 0;
+    }
+
+    int count = 0;
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
+        chips[count++] = chip;
+    }
+    return count;
+}
 
-        printf("  Chip %d initialized (Priority: %d)\n", chip, chip_systems[chip].priority_level);
+/**
+ * @brief Apply a register value pushed by hardware (interrupt or trace)
+ * @param fleet Fleet owning the register
+ * @param address Register address
+ * @param value New register value
+ * @return true if the address belongs to an active chip's register
+ *
+ * The owning chip and register are found through the fleet address
+ * index in constant time; the register is revalidated against its bounds
+ * and, if the chip has them, its bitfield rules.
+ */
+bool apply_register_update(chip_fleet_t *fleet, uint32_t address, uint32_t value) {
+    register_slot_t slot;
+    if (fleet == NULL || !find_register_by_address(&fleet->address_index, address, &slot) ||
+        !chip_is_active(fleet, slot.chip)) {
+        return false;
     }
 
-    active_chip_count = num_chips;
-    printf("Multi-chip system initialization complete\n");
+    monitor_system_t *monitor = &fleet->chips[slot.chip].monitor;
+    uint32_t previous = register_value(monitor, slot.reg);
+    set_register_value(monitor, slot.reg, value);
+    bool is_valid = value >= register_min(monitor, slot.reg) && value <= register_max(monitor, slot.reg) &&
+                    register_fields_valid(monitor->field_checks, monitor->regs.values, slot.reg);
+    set_register_valid(monitor, slot.reg, is_valid);
+    if (!is_valid) {
+        monitor->error_count++;
+    }
+
+    report_register(REPORT_REGISTER_CHANGE, is_valid ? REPORT_PASS : REPORT_FAIL, slot.chip,
+                    register_name(monitor, slot.reg), address, value, previous);
     return true;
 }
 
 /**
  * @brief Scan all registers across all chips using nested loops
+ * @param fleet Fleet to scan
  * @return Total number of valid registers found
  */
-int scan_all_chips_registers(void) {
+int scan_all_chips_registers(chip_fleet_t *fleet) {
+    if (fleet == NULL) {
+        return 0;
+    }
+
     printf("=== Multi-Chip Register Scan ===\n");
 
+    chip_system_t *chip_systems = fleet->chips;
+
     int total_valid = 0;
     int total_scanned = 0;
 
-    // Outer loop: iterate through all chips
-    for (int chip = 0; chip < active_chip_count; chip++) {
-        if (!chip_systems[chip].is_active) {
-            printf("Chip %d: INACTIVE - skipping\n", chip);
-            continue; // Skip inactive chips
-        }
+    // Outer loop: iterate through the active chips
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
+        report_register(REPORT_CHIP_SCAN_BEGIN, REPORT_PASS, chip, NULL, 0,
+                        (uint32_t)chip_systems[chip].priority_level, 0);
 
-        printf("Scanning Chip %d (Priority %d):\n", chip, chip_systems[chip].priority_level);
+        // Read and validate the chip's whole register set in one batch
+        read_system_registers_bulk(&chip_systems[chip].monitor);
+        validate_system_registers(&chip_systems[chip].monitor);
 
         // Inner loop: iterate through registers in current chip
         for (int reg = 0; reg < chip_systems[chip].monitor.num_registers; reg++) {
             total_scanned++;
 
-            // Read register value
-            uint32_t value = read_register(chip_systems[chip].monitor.registers[reg].address);
-            chip_systems[chip].monitor.registers[reg].value = value;
+            uint32_t value = register_value(&chip_systems[chip].monitor, reg);
+            bool is_valid = register_is_valid(&chip_systems[chip].monitor, reg);
 
-            // Validate register
-            bool is_valid = validate_register(
-                chip_systems[chip].monitor.registers[reg].address,
-                value,
-                chip_systems[chip].monitor.registers[reg].expected_min,
-                chip_systems[chip].monitor.registers[reg].expected_max
-            );
-
-            chip_systems[chip].monitor.registers[reg].is_valid = is_valid;
+            if (report_sink_listening()) {
+                report_register(REPORT_REGISTER_CHECK, is_valid ? REPORT_PASS : REPORT_FAIL, chip,
+                                register_name(&chip_systems[chip].monitor, reg),
+                                register_address(&chip_systems[chip].monitor, reg), value, 0);
+            }
 
             if (is_valid) {
                 total_valid++;
-                printf("  %s: 0x%08X ✓\n",
-                       chip_systems[chip].monitor.registers[reg].name, value);
             } else {
-                printf("  %s: 0x%08X ✗\n",
-                       chip_systems[chip].monitor.registers[reg].name, value);
                 chip_systems[chip].monitor.error_count++;
 
                 // Early termination for critical chip failures
@@ -139,25 +293,380 @@ int scan_all_chips_registers(void) {
             }
         }
 
-        printf("  Chip %d scan complete: %d/%d valid\n",
-               chip, count_valid_registers(&chip_systems[chip].monitor),
-               chip_systems[chip].monitor.num_registers);
+        report_register(REPORT_CHIP_SCAN_END, REPORT_PASS, chip, NULL, 0,
+                        (uint32_t)count_valid_registers(&chip_systems[chip].monitor),
+                        (uint32_t)chip_systems[chip].monitor.num_registers);
     }
 
     printf("Multi-chip scan complete: %d/%d registers valid across %d chips\n",
-           total_valid, total_scanned, active_chip_count);
+           total_valid, total_scanned, fleet->active_chip_count);
 
     return total_valid;
 }
 
 /**
- * @brief Priority-based monitoring with nested loops and optimization
+ * @brief Outcome of one chip in a parallel fleet scan
+ */
+typedef struct {
+    int valid;    // Valid registers counted
+    int checked;  // Registers checked before the chip finished or aborted, -1 if skipped
+    size_t saved_values;     // Offset of the chip's saved values in the scan's value buffer
+    size_t saved_masks;      // Offset of the chip's saved bitmaps in the scan's mask buffer
+    uint32_t saved_sequence;
+    int saved_errors;
+} chip_scan_result_t;
+
+/**
+ * @brief Shared state of a parallel fleet scan
+ */
+typedef struct {
+    chip_fleet_t *fleet;
+    const int *chips;             // Active chips, in chip order
+    chip_scan_result_t *results;  // One per active chip
+    uint32_t *saved_values;       // Register and shadow values of each chip before its read
+    uint64_t *saved_masks;        // Validity and shadow-valid bitmaps of each chip before its read
+    atomic_int abort_chip;        // Lowest chip that tripped the early-abort rule, INT_MAX if none
+} fleet_scan_t;
+
+/**
+ * @brief Copy the chip state a scan changes into a scan's save buffers
+ */
+static void save_chip_state(const fleet_scan_t *scan, const monitor_system_t *monitor,
+                            chip_scan_result_t *result) {
+    size_t n = (size_t)monitor->num_registers;
+    size_t words = REGISTER_BITMAP_WORDS(n);
+    uint32_t *values = scan->saved_values + result->saved_values;
+    uint64_t *masks = scan->saved_masks + result->saved_masks;
+
+    memcpy(values, monitor->regs.values, n * sizeof(uint32_t));
+    memcpy(values + n, monitor->shadow_values, n * sizeof(uint32_t));
+    memcpy(masks, monitor->regs.valid, words * sizeof(uint64_t));
+    memcpy(masks + words, monitor->shadow_valid, words * sizeof(uint64_t));
+    result->saved_sequence = monitor->sim_sequence;
+    result->saved_errors = monitor->error_count;
+}
+
+/**
+ * @brief Undo a chip's scan from the state saved before it was read
+ */
+static void restore_chip_state(const fleet_scan_t *scan, monitor_system_t *monitor,
+                               const chip_scan_result_t *result) {
+    size_t n = (size_t)monitor->num_registers;
+    size_t words = REGISTER_BITMAP_WORDS(n);
+    const uint32_t *values = scan->saved_values + result->saved_values;
+    const uint64_t *masks = scan->saved_masks + result->saved_masks;
+
+    memcpy(monitor->regs.values, values, n * sizeof(uint32_t));
+    memcpy(monitor->shadow_values, values + n, n * sizeof(uint32_t));
+    memcpy(monitor->regs.valid, masks, words * sizeof(uint64_t));
+    memcpy(monitor->shadow_valid, masks + words, words * sizeof(uint64_t));
+    monitor->sim_sequence = result->saved_sequence;
+    monitor->error_count = result->saved_errors;
+}
+
+/**
+ * @brief Scan one chip of a parallel fleet scan
+ *
+ * Chips above a chip that has already tripped the early-abort rule are
+ * skipped, so an abort halts the rest of the scan within one chip per worker.
+ */
+static void scan_chip_task(void *context, uint32_t item, int worker) {
+    fleet_scan_t *scan = context;
+    int chip = scan->chips[item];
+    chip_system_t *record = &scan->fleet->chips[chip];
+    chip_scan_result_t *result = &scan->results[item];
+    (void)worker;
+
+    result->valid = 0;
+    result->checked = -1;
+    if (chip > atomic_load_explicit(&scan->abort_chip, memory_order_relaxed)) {
+        return;
+    }
+
+    // A later abort below this chip rolls the read back
+    save_chip_state(scan, &record->monitor, result);
+    result->checked = 0;
+    read_system_registers_bulk(&record->monitor);
+    validate_system_registers(&record->monitor);
+
+    for (int reg = 0; reg < record->monitor.num_registers; reg++) {
+        result->checked = reg + 1;
+        if (register_is_valid(&record->monitor, reg)) {
+            result->valid++;
+            continue;
+        }
+
+        record->monitor.error_count++;
+        if (record->priority_level == 1 && record->monitor.error_count >= 3) {
+            int lowest = atomic_load(&scan->abort_chip);
+            while (chip < lowest && !atomic_compare_exchange_weak(&scan->abort_chip, &lowest, chip)) {
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Report one chip's scan as the serial scan does
+ * @param record Scanned chip
+ * @param last_reg Last register that was checked
+ * @param finished false if the scan was aborted on this chip
+ */
+static void report_chip_scan(const chip_system_t *record, int last_reg, bool finished) {
+    const monitor_system_t *monitor = &record->monitor;
+
+    report_register(REPORT_CHIP_SCAN_BEGIN, REPORT_PASS, record->chip_id, NULL, 0,
+                    (uint32_t)record->priority_level, 0);
+    for (int reg = 0; reg <= last_reg; reg++) {
+        bool is_valid = register_is_valid(monitor, reg);
+        report_register(REPORT_REGISTER_CHECK, is_valid ? REPORT_PASS : REPORT_FAIL, record->chip_id,
+                        register_name(monitor, reg), register_address(monitor, reg),
+                        register_value(monitor, reg), 0);
+    }
+    if (finished) {
+        report_register(REPORT_CHIP_SCAN_END, REPORT_PASS, record->chip_id, NULL, 0,
+                        (uint32_t)count_valid_registers(monitor), (uint32_t)monitor->num_registers);
+    }
+}
+
+/**
+ * @brief Scan all registers across all chips with the work-stealing scheduler
+ * @param fleet Fleet to scan
+ * @param scheduler Task scheduler (NULL scans on the calling thread)
+ * @return Total number of valid registers found, exactly as scan_all_chips_registers()
+ *
+ * Every active chip is one task, so chips of different sizes balance across
+ * the workers. Each task records its chip's counts; they are reduced in
+ * chip order up to the first chip that tripped the early-abort rule, so
+ * the result and the reported events (emitted afterwards, in chip order,
+ * on the calling thread) match the serial scan. Chips above an abort may
+ * still have been read before the abort was seen: each task saves its
+ * chip's values, bitmaps, simulated sequence and error count first, and
+ * those chips are restored, so the fleet ends up as after the serial
+ * scan. Transfers already issued for them (e.g. reads recorded in a
+ * trace) cannot be taken back.
+ */
+int scan_all_chips_registers_parallel(chip_fleet_t *fleet, task_scheduler_t *scheduler) {
+    if (fleet == NULL) {
+        return 0;
+    }
+
+    int *chips = malloc(((size_t)fleet->active_chip_count + 1) * sizeof(int));
+    chip_scan_result_t *results = malloc(((size_t)fleet->active_chip_count + 1) * sizeof(chip_scan_result_t));
+    int count = (chips != NULL && results != NULL) ? list_active_chips(fleet, chips) : 0;
+
+    // Room to save every chip's values (registers and shadows) and bitmaps
+    size_t value_words = 0;
+    size_t mask_words = 0;
+    for (int i = 0; i < count; i++) {
+        int num_registers = fleet->chips[chips[i]].monitor.num_registers;
+        results[i].saved_values = value_words;
+        results[i].saved_masks = mask_words;
+        value_words += 2 * (size_t)num_registers;
+        mask_words += 2 * REGISTER_BITMAP_WORDS(num_registers);
+    }
+    uint32_t *saved_values = malloc((value_words + 1) * sizeof(uint32_t));
+    uint64_t *saved_masks = malloc((mask_words + 1) * sizeof(uint64_t));
+
+    if (chips == NULL || results == NULL || saved_values == NULL || saved_masks == NULL) {
+        free(chips);
+        free(results);
+        free(saved_values);
+        free(saved_masks);
+        return scan_all_chips_registers(fleet);
+    }
+
+    printf("=== Multi-Chip Register Scan ===\n");
+
+    fleet_scan_t scan = {fleet, chips, results, saved_values, saved_masks, INT_MAX};
+    run_scheduled_tasks(scheduler, (uint32_t)count, scan_chip_task, &scan);
+    int abort_chip = atomic_load(&scan.abort_chip);
+
+    // Chips past the abort were never reached by the serial scan
+    for (int i = count - 1; i >= 0 && chips[i] > abort_chip; i--) {
+        if (results[i].checked >= 0) {
+            restore_chip_state(&scan, &fleet->chips[chips[i]].monitor, &results[i]);
+        }
+    }
+
+    // Deterministic reduction in chip order, none past the abort; the
+    // serial scan's output is replayed alongside
+    int total_valid = 0;
+    int total_scanned = 0;
+    for (int i = 0; i < count && chips[i] <= abort_chip; i++) {
+        total_valid += results[i].valid;
+        total_scanned += results[i].checked;
+        if (report_sink_listening()) {
+            report_chip_scan(&fleet->chips[chips[i]], results[i].checked - 1, chips[i] != abort_chip);
+        }
+    }
+    free(chips);
+    free(results);
+    free(saved_values);
+    free(saved_masks);
+
+    if (abort_chip != INT_MAX) {
+        printf("  CRITICAL: High-priority chip %d has too many errors, aborting scan\n", abort_chip);
+        return total_valid;
+    }
+
+    printf("Multi-chip scan complete: %d/%d registers valid across %d chips\n",
+           total_valid, total_scanned, fleet->active_chip_count);
+    return total_valid;
+}
+
+/**
+ * @brief Delta scan: report only registers that changed
+ * @param fleet Fleet to scan
+ * @param changes Receives the compact change list (may be NULL)
+ * @param max_changes Capacity of changes
+ * @return Number of changed registers across all chips
+ *
+ * Each new value is compared against the last stored register value.
+ * Unchanged registers are not printed.
+ * If more registers change than fit in changes, all are still validated
+ * and counted. The early-abort rule of the full scan still applies.
+ * The previous values are kept in one buffer sized for the largest chip
+ * and reused for every chip of the pass.
+ */
+int scan_all_chips_registers_delta(chip_fleet_t *fleet, register_change_t *changes, int max_changes) {
+    if (fleet == NULL) {
+        return 0;
+    }
+
+    printf("=== Multi-Chip Delta Scan ===\n");
+
+    chip_system_t *chip_systems = fleet->chips;
+
+    int largest = 0;
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
+        int count = chip_systems[chip].monitor.num_registers;
+        largest = (count > largest) ? count : largest;
+    }
+    uint32_t *previous = malloc(sizeof(uint32_t) * (size_t)(largest > 0 ? largest : 1));
+    if (previous == NULL) {
+        printf("Error: Out of memory for the delta scan\n");
+        return 0;
+    }
+
+    int total_changed = 0;
+    int total_scanned = 0;
+
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
+        monitor_system_t *monitor = &chip_systems[chip].monitor;
+        memcpy(previous, monitor->regs.values, sizeof(uint32_t) * (size_t)monitor->num_registers);
+
+        read_system_registers_bulk(monitor);
+        validate_system_registers(monitor);
+        total_scanned += monitor->num_registers;
+
+        for (int reg = 0; reg < monitor->num_registers; reg++) {
+            uint32_t value = register_value(monitor, reg);
+            bool is_valid = register_is_valid(monitor, reg);
+            if (value == previous[reg]) {
+                continue; // Unchanged since the last pass
+            }
+
+            if (changes != NULL && total_changed < max_changes) {
+                changes[total_changed].chip_id = chip;
+                changes[total_changed].reg_index = reg;
+                changes[total_changed].old_value = previous[reg];
+                changes[total_changed].new_value = value;
+                changes[total_changed].is_valid = is_valid;
+            }
+            total_changed++;
+
+            if (report_sink_listening()) {
+                report_register(REPORT_REGISTER_CHANGE, is_valid ? REPORT_PASS : REPORT_FAIL, chip,
+                                register_name(monitor, reg), register_address(monitor, reg), value,
+                                previous[reg]);
+            }
+
+            if (!is_valid) {
+                monitor->error_count++;
+
+                // Early termination for critical chip failures
+                if (chip_systems[chip].priority_level == 1 && monitor->error_count >= 3) {
+                    printf("  CRITICAL: High-priority chip %d has too many errors, aborting scan\n", chip);
+                    free(previous);
+                    return total_changed; // Early exit
+                }
+            }
+        }
+    }
+
+    free(previous);
+    printf("Delta scan complete: %d/%d registers changed\n", total_changed, total_scanned);
+    return total_changed;
+}
+
+/**
+ * @brief Chips due in the current monitoring iteration
+ */
+typedef struct {
+    uint64_t *keys;  // (priority << 32) | chip, one per due chip
+    size_t count;
+    const chip_system_t *chips;
+} due_chips_t;
+
+/**
+ * @brief Monitoring iterations between two samples of a chip (at least 1)
+ */
+static uint32_t chip_sample_period(const chip_system_t *record) {
+    return (record->sample_period > 0) ? record->sample_period : 1;
+}
+
+/**
+ * @brief Timer wheel callback: note a chip whose sample is due
+ */
+static void collect_due_chip(void *context, uint32_t chip, uint64_t deadline) {
+    due_chips_t *due = context;
+    (void)deadline;
+    due->keys[due->count++] = ((uint64_t)(uint32_t)due->chips[chip].priority_level << 32) | chip;
+}
+
+static int compare_due_chips(const void *a, const void *b) {
+    uint64_t key_a = *(const uint64_t *)a;
+    uint64_t key_b = *(const uint64_t *)b;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+/**
+ * @brief Priority-based monitoring driven by per-chip sampling deadlines
+ * @param fleet Fleet to monitor
  * @param duration_seconds How long to monitor
+ *
+ * Each chip is sampled every sample_period iterations of CHIP_SCAN_INTERVAL
+ * ms. Deadlines are kept in a timer wheel, so an iteration only touches
+ * the chips that are due, however large the fleet is.
  */
-void priority_based_monitoring(int duration_seconds) {
+void priority_based_monitoring(chip_fleet_t *fleet, int duration_seconds) {
+    if (fleet == NULL) {
+        return;
+    }
+
+    chip_system_t *chip_systems = fleet->chips;
     printf("=== Priority-Based Multi-Chip Monitoring ===\n");
     printf("Monitoring for %d seconds with priority optimization...\n", duration_seconds);
 
+    // Every active chip is due first after one sampling period
+    timer_wheel_t wheel;
+    due_chips_t due = {malloc((size_t)fleet->num_chips * sizeof(uint64_t)), 0, chip_systems};
+    if (due.keys == NULL || !timer_wheel_init(&wheel, (uint32_t)fleet->num_chips)) {
+        printf("Error: Out of memory for the monitoring schedule\n");
+        free(due.keys);
+        return;
+    }
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
+        timer_wheel_schedule(&wheel, (uint32_t)chip, chip_sample_period(&chip_systems[chip]));
+    }
+
+    // With a register file attached, medium and low priority chips are read
+    // asynchronously while the high priority chips are being checked
+    unsigned depth = ((unsigned)fleet->num_chips < FLEET_POLL_DEPTH) ? (unsigned)fleet->num_chips
+                                                                     : FLEET_POLL_DEPTH;
+    register_poller_t *poller = open_register_poller(depth);
+
     time_t start_time = time(NULL);
     int iteration = 0;
 
@@ -165,9 +674,26 @@ void priority_based_monitoring(int duration_seconds) {
         iteration++;
         printf("\n--- Monitoring Iteration %d ---\n", iteration);
 
-        // Priority 1 (High): Monitor every iteration
-        for (int chip = 0; chip < active_chip_count; chip++) {
-            if (!chip_systems[chip].is_active || chip_systems[chip].priority_level != 1) {
+        // Only the chips whose deadline is this iteration, by priority and then chip
+        due.count = 0;
+        timer_wheel_advance(&wheel, (uint64_t)iteration, collect_due_chip, &due);
+        qsort(due.keys, due.count, sizeof(uint64_t), compare_due_chips);
+
+        size_t first_lower = 0;  // First due chip below high priority
+        for (size_t i = 0; i < due.count; i++) {
+            chip_system_t *record = &chip_systems[(uint32_t)due.keys[i]];
+            first_lower += (record->priority_level == 1);
+            record->polled = poller != NULL && record->priority_level != 1 &&
+                             register_poller_submit(poller, &record->monitor);
+        }
+        if (poller != NULL) {
+            register_poller_kick(poller);
+        }
+
+        // High priority chips are checked while the asynchronous reads are in flight
+        for (size_t i = 0; i < first_lower; i++) {
+            int chip = (int)(uint32_t)due.keys[i];
+            if (!chip_is_active(fleet, chip)) {
                 continue;
             }
 
@@ -178,37 +704,37 @@ void priority_based_monitoring(int duration_seconds) {
             if (check_critical_conditions(&chip_systems[chip].monitor)) {
                 printf("CRITICAL: High-priority chip %d failure detected!\n", chip);
                 // Implement emergency response
-                chip_systems[chip].is_active = false;
-                active_chip_count--;
+                deactivate_chip(fleet, chip);
             }
         }
 
-        // Priority 2 (Medium): Monitor every 2nd iteration
-        if (iteration % 2 == 0) {
-            for (int chip = 0; chip < active_chip_count; chip++) {
-                if (!chip_systems[chip].is_active || chip_systems[chip].priority_level != 2) {
-                    continue;
-                }
+        // Wait for the asynchronous reads before the lower priorities are checked
+        register_poller_reap(poller, true);
 
-                printf("Medium Priority - Chip %d:\n", chip);
+        for (size_t i = first_lower; i < due.count; i++) {
+            int chip = (int)(uint32_t)due.keys[i];
+            if (!chip_is_active(fleet, chip)) {
+                continue;
+            }
+
+            printf("%s Priority - Chip %d:\n",
+                   (chip_systems[chip].priority_level == 2) ? "Medium" : "Low", chip);
+            if (!chip_systems[chip].polled) {
                 update_all_registers(&chip_systems[chip].monitor);
             }
         }
 
-        // Priority 3 (Low): Monitor every 3rd iteration
-        if (iteration % 3 == 0) {
-            for (int chip = 0; chip < active_chip_count; chip++) {
-                if (!chip_systems[chip].is_active || chip_systems[chip].priority_level != 3) {
-                    continue;
-                }
-
-                printf("Low Priority - Chip %d:\n", chip);
-                update_all_registers(&chip_systems[chip].monitor);
+        // Chips still active are due again one sampling period from now
+        for (size_t i = 0; i < due.count; i++) {
+            chip_system_t *record = &chip_systems[(uint32_t)due.keys[i]];
+            if (chip_is_active(fleet, record->chip_id)) {
+                timer_wheel_schedule(&wheel, (uint32_t)record->chip_id,
+                                     (uint64_t)iteration + chip_sample_period(record));
             }
         }
 
         // Check if all chips are inactive
-        if (active_chip_count == 0) {
+        if (fleet->active_chip_count == 0) {
             printf("All chips inactive - terminating monitoring\n");
             break;
         }
@@ -217,101 +743,299 @@ void priority_based_monitoring(int duration_seconds) {
         delay_ms(CHIP_SCAN_INTERVAL);
     }
 
+    close_register_poller(poller);
+    timer_wheel_destroy(&wheel);
+    free(due.keys);
     printf("Priority-based monitoring completed after %d iterations\n", iteration);
 }
 
+/**
+ * @brief Comparison of two chips
+ */
+typedef struct {
+    float voltage_diff;
+    float temp_diff;
+    float match_percentage;  // Registers with the same validity, relative to the first chip
+} chip_pair_correlation_t;
+
+/**
+ * @brief Compare the sensors and register patterns of two chips
+ */
+static chip_pair_correlation_t correlate_chip_pair(const monitor_system_t *first,
+                                                   const monitor_system_t *second) {
+    chip_pair_correlation_t pair;
+    pair.voltage_diff = first->voltage - second->voltage;
+    pair.temp_diff = first->temperature - second->temperature;
+
+    // Compare register patterns: XOR of the validity bitmaps, then popcount
+    int common_registers = (first->num_registers < second->num_registers) ?
+                           first->num_registers : second->num_registers;
+    int matching_registers = common_registers - register_validity_mismatches(first, second);
+    pair.match_percentage = (float)matching_registers / first->num_registers * 100.0f;
+    return pair;
+}
+
 /**
  * @brief Cross-chip correlation analysis using nested loops
+ * @param fleet Fleet to analyze
  */
-void cross_chip_correlation_analysis(void) {
-    printf("=== Cross-Chip Correlation Analysis ===\n");
+void cross_chip_correlation_analysis(const chip_fleet_t *fleet) {
+    if (fleet == NULL) {
+        return;
+    }
 
-    // Nested loops for chip-to-chip comparison
-    for (int chip1 = 0; chip1 < active_chip_count; chip1++) {
-        if (!chip_systems[chip1].is_active) continue;
+    printf("=== Cross-Chip Correlation Analysis ===\n");
 
-        for (int chip2 = chip1 + 1; chip2 < active_chip_count; chip2++) {
-            if (!chip_systems[chip2].is_active) continue;
+    const chip_system_t *chip_systems = fleet->chips;
 
+    // Nested loops for chip-to-chip comparison over the active chips
+    for (int chip1 = next_active_chip(fleet, -1); chip1 >= 0; chip1 = next_active_chip(fleet, chip1)) {
+        for (int chip2 = next_active_chip(fleet, chip1); chip2 >= 0; chip2 = next_active_chip(fleet, chip2)) {
             printf("Comparing Chip %d vs Chip %d:\n", chip1, chip2);
+            chip_pair_correlation_t pair = correlate_chip_pair(&chip_systems[chip1].monitor,
+                                                               &chip_systems[chip2].monitor);
 
             // Compare voltage levels
-            float voltage_diff = chip_systems[chip1].monitor.voltage -
-                               chip_systems[chip2].monitor.voltage;
-            printf("  Voltage difference: %.3fV\n", voltage_diff);
-
-            if (fabs(voltage_diff) > 0.2f) {
+            printf("  Voltage difference: %.3fV\n", pair.voltage_diff);
+            if (fabs(pair.voltage_diff) > 0.2f) {
                 printf("  WARNING: Significant voltage difference detected\n");
             }
 
             // Compare temperature levels
-            float temp_diff = chip_systems[chip1].monitor.temperature -
-                            chip_systems[chip2].monitor.temperature;
-            printf("  Temperature difference: %.1f°C\n", temp_diff);
-
-            if (fabs(temp_diff) > 10.0f) {
+            printf("  Temperature difference: %.1f°C\n", pair.temp_diff);
+            if (fabs(pair.temp_diff) > 10.0f) {
                 printf("  WARNING: Significant temperature difference detected\n");
             }
 
-            // Compare register patterns
-            int matching_registers = 0;
-            for (int reg = 0; reg < chip_systems[chip1].monitor.num_registers &&
-                              reg < chip_systems[chip2].monitor.num_registers; reg++) {
-
-                if (chip_systems[chip1].monitor.registers[reg].is_valid ==
-                    chip_systems[chip2].monitor.registers[reg].is_valid) {
-                    matching_registers++;
-                }
+            printf("  Register pattern match: %.1f%%\n", pair.match_percentage);
+            if (pair.match_percentage < 80.0f) {
+                printf("  WARNING: Low register pattern correlation\n");
             }
+        }
+    }
+}
+
+/**
+ * @brief Shared state of a correlation summary
+ */
+typedef struct {
+    const chip_fleet_t *fleet;
+    const int *chips;                  // Active chips, in chip order
+    int num_chips;
+    chip_correlation_summary_t *rows;  // Row i counts the pairs (chips[i], chips[j > i])
+} correlation_scan_t;
 
-            float match_percentage = (float)matching_registers /
-                                   chip_systems[chip1].monitor.num_registers * 100.0f;
-            printf("  Register pattern match: %.1f%%\n", match_percentage);
+/**
+ * @brief Compare one active chip against every higher active chip
+ *
+ * Rows shrink from num_chips - 1 pairs to none, which is the uneven
+ * work the scheduler's stealing evens out.
+ */
+static void correlate_row_task(void *context, uint32_t item, int worker) {
+    correlation_scan_t *scan = context;
+    const chip_system_t *chip_systems = scan->fleet->chips;
+    chip_correlation_summary_t *row = &scan->rows[item];
+    const monitor_system_t *first = &chip_systems[scan->chips[item]].monitor;
+    (void)worker;
+
+    *row = (chip_correlation_summary_t){0, 0, 0, 0};
+    for (int j = (int)item + 1; j < scan->num_chips; j++) {
+        chip_pair_correlation_t pair = correlate_chip_pair(first, &chip_systems[scan->chips[j]].monitor);
+        row->pairs++;
+        row->voltage_warnings += (fabs(pair.voltage_diff) > 0.2f);
+        row->temperature_warnings += (fabs(pair.temp_diff) > 10.0f);
+        row->pattern_warnings += (pair.match_percentage < 80.0f);
+    }
+}
 
-            if (match_percentage < 80.0f) {
-                printf("  WARNING: Low register pattern correlation\n");
-            }
+/**
+ * @brief Count the correlation warnings over every pair of active chips
+ * @param fleet Fleet to analyze
+ * @param scheduler Task scheduler (NULL compares on the calling thread)
+ * @param summary Receives the pair and warning counts
+ * @return true if computed, false on NULL arguments or out of memory
+ *
+ * Applies the thresholds of cross_chip_correlation_analysis() without
+ * printing each pair; each row of pairs is one task.
+ */
+bool summarize_chip_correlation(const chip_fleet_t *fleet, task_scheduler_t *scheduler,
+                                chip_correlation_summary_t *summary) {
+    if (fleet == NULL || summary == NULL) {
+        return false;
+    }
+
+    size_t capacity = (size_t)fleet->active_chip_count + 1;
+    int *chips = malloc(capacity * sizeof(int));
+    chip_correlation_summary_t *rows = malloc(capacity * sizeof(chip_correlation_summary_t));
+    if (chips == NULL || rows == NULL) {
+        free(chips);
+        free(rows);
+        return false;
+    }
+
+    int count = list_active_chips(fleet, chips);
+    correlation_scan_t scan = {fleet, chips, count, rows};
+    run_scheduled_tasks(scheduler, (uint32_t)count, correlate_row_task, &scan);
+
+    *summary = (chip_correlation_summary_t){0, 0, 0, 0};
+    for (int i = 0; i < count; i++) {
+        summary->pairs += rows[i].pairs;
+        summary->voltage_warnings += rows[i].voltage_warnings;
+        summary->temperature_warnings += rows[i].temperature_warnings;
+        summary->pattern_warnings += rows[i].pattern_warnings;
+    }
+    free(chips);
+    free(rows);
+    return true;
+}
+
+/**
+ * @brief Classify the sensor readings of every active chip in one batch
+ * @param fleet Fleet to evaluate
+ * @return Number of chips in critical condition, or -1 if out of memory
+ */
+int evaluate_fleet_status(chip_fleet_t *fleet) {
+    if (fleet == NULL) {
+        return 0;
+    }
+
+    printf("=== Fleet Status Evaluation ===\n");
+
+    chip_system_t *chip_systems = fleet->chips;
+    size_t n = (size_t)fleet->num_chips;
+    float *voltage = malloc(n * sizeof(float));
+    float *temperature = malloc(n * sizeof(float));
+    float *current = malloc(n * sizeof(float));
+    system_status_t *status = malloc(n * sizeof(system_status_t));
+    int *chip_ids = malloc(n * sizeof(int));
+
+    if (voltage == NULL || temperature == NULL || current == NULL || status == NULL ||
+        chip_ids == NULL) {
+        printf("ERROR: Out of memory for %zu chip readings\n", n);
+        free(voltage);
+        free(temperature);
+        free(current);
+        free(status);
+        free(chip_ids);
+        return -1;
+    }
+
+    // Gather the readings as structure-of-arrays
+    int count = 0;
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
+        voltage[count] = chip_systems[chip].monitor.voltage;
+        temperature[count] = chip_systems[chip].monitor.temperature;
+        current[count] = chip_systems[chip].monitor.current;
+        chip_ids[count] = chip;
+        count++;
+    }
+
+    int critical = 0;
+    int warning = 0;
+    if (count > 0) {
+        critical = (int)determine_system_status_batch(voltage, temperature, current,
+                                                      (size_t)count, status);
+        for (int i = 0; i < count; i++) {
+            chip_systems[chip_ids[i]].monitor.status = status[i];
+            warning += (status[i] == STATUS_WARNING);
         }
     }
+
+    printf("Fleet status: %d normal, %d warning, %d critical\n",
+           count - warning - critical, warning, critical);
+
+    free(voltage);
+    free(temperature);
+    free(current);
+    free(status);
+    free(chip_ids);
+    return critical;
+}
+
+/**
+ * @brief Active chips of a batch read
+ */
+typedef struct {
+    chip_fleet_t *fleet;
+    const int *chips;
+} batch_read_t;
+
+/**
+ * @brief Read one chip's registers for batch processing
+ */
+static void read_chip_task(void *context, uint32_t item, int worker) {
+    batch_read_t *batch = context;
+    (void)worker;
+
+    // Whole register set in one bulk transfer
+    read_system_registers_bulk(&batch->fleet->chips[batch->chips[item]].monitor);
 }
 
 /**
  * @brief Optimized batch processing with loop unrolling
+ * @param fleet Fleet to process
+ * @param scheduler Task scheduler reading the chips (NULL reads on the calling thread)
  */
-void optimized_batch_processing(void) {
+void optimized_batch_processing(chip_fleet_t *fleet, task_scheduler_t *scheduler) {
+    if (fleet == NULL) {
+        return;
+    }
+
     printf("=== Optimized Batch Processing ===\n");
 
-    // Process chips in batches of 4 for optimization
+    int *chips = malloc(((size_t)fleet->active_chip_count + 1) * sizeof(int));
+    if (chips == NULL) {
+        printf("ERROR: Out of memory for %d chips\n", fleet->active_chip_count);
+        return;
+    }
+    int count = list_active_chips(fleet, chips);
+
+    // Every active chip's bulk read is one task
+    batch_read_t batch = {fleet, chips};
+    run_scheduled_tasks(scheduler, (uint32_t)count, read_chip_task, &batch);
+
+    // Report active chips in batches of 4
     const int BATCH_SIZE = 4;
 
-    for (int batch_start = 0; batch_start < active_chip_count; batch_start += BATCH_SIZE) {
-        int batch_end = (batch_start + BATCH_SIZE < active_chip_count) ?
-                        batch_start + BATCH_SIZE : active_chip_count;
+    for (int batch_start = 0; batch_start < count; batch_start += BATCH_SIZE) {
+        int batch_end = (batch_start + BATCH_SIZE < count) ? batch_start + BATCH_SIZE : count;
 
-        printf("Processing batch: chips %d-%d\n", batch_start, batch_end - 1);
+        printf("Processing batch: chips %d-%d\n", chips[batch_start], chips[batch_end - 1]);
 
-        // Unrolled loop for better performance (process 4 chips simultaneously)
         for (int i = batch_start; i < batch_end; i++) {
-            if (!chip_systems[i].is_active) continue;
+            printf("  Chip %d: Registers read\n", chips[i]);
+        }
+
+        printf("  Batch %d processing complete\n", batch_start / BATCH_SIZE);
+    }
+    free(chips);
+}
 
-            // Parallel processing simulation
-            printf("  Chip %d: Reading registers...\n", i);
+/**
+ * @brief Create a fleet and report its chips
+ * @param num_chips Number of chips to monitor
+ * @return New fleet, or NULL on failure
+ */
+static chip_fleet_t *init_multi_chip_system(int num_chips) {
+    if (num_chips <= 0 || num_chips > MAX_FLEET_CHIPS) {
+        printf("ERROR: Invalid number of chips (%d). Must be 1-%d\n", num_chips, MAX_FLEET_CHIPS);
+        return NULL;
+    }
 
-            // Process registers in groups of 4 for cache efficiency
-            for (int reg = 0; reg < chip_systems[i].monitor.num_registers; reg += 4) {
-                int reg_end = (reg + 4 < chip_systems[i].monitor.num_registers) ?
-                              reg + 4 : chip_systems[i].monitor.num_registers;
+    printf("Initializing multi-chip monitoring system with %d chips...\n", num_chips);
 
-                // Unrolled register processing
-                for (int r = reg; r < reg_end; r++) {
-                    uint32_t value = read_register(chip_systems[i].monitor.registers[r].address);
-                    chip_systems[i].monitor.registers[r].value = value;
-                }
-            }
-        }
+    chip_fleet_t *fleet = create_chip_fleet(num_chips);
+    if (fleet == NULL) {
+        printf("ERROR: Out of memory for %d chips\n", num_chips);
+        return NULL;
+    }
 
-        printf("  Batch %d processing complete\n", batch_start / BATCH_SIZE);
+    for (int chip = 0; chip < fleet->num_chips; chip++) {
+        printf("  Chip %d initialized (Priority: %d)\n", chip, fleet->chips[chip].priority_level);
     }
+
+    printf("Multi-chip system initialization complete (%zu bytes)\n", chip_fleet_footprint(fleet));
+    return fleet;
 }
 
 /**
@@ -322,23 +1046,55 @@ int multi_chip_monitoring(int num_chips) {
     printf("Multi-Chip Monitoring System\n\n");
 
     // Initialize system
-    if (!init_multi_chip_system(num_chips)) {
+    chip_fleet_t *fleet = init_multi_chip_system(num_chips);
+    if (fleet == NULL) {
         return -1;
     }
+    chip_system_t *chip_systems = fleet->chips;
+
+    // One worker per CPU; without threads the scheduler runs tasks inline
+    worker_pool_t *pool = create_worker_pool(0);
+    task_scheduler_t *scheduler = create_task_scheduler(pool);
 
     // Demonstrate advanced loop patterns
     printf("\n1. Nested Loop Register Scanning:\n");
-    int valid_registers = scan_all_chips_registers();
+    int valid_registers = scan_all_chips_registers(fleet);
     printf("Total valid registers: %d\n", valid_registers);
 
     printf("\n2. Priority-Based Monitoring (10 seconds):\n");
-    priority_based_monitoring(10);
+    priority_based_monitoring(fleet, 10);
 
     printf("\n3. Cross-Chip Correlation Analysis:\n");
-    cross_chip_correlation_analysis();
+    cross_chip_correlation_analysis(fleet);
+    chip_correlation_summary_t correlation;
+    if (summarize_chip_correlation(fleet, scheduler, &correlation)) {
+        printf("Correlation summary: %ld pairs, %ld voltage, %ld temperature, %ld pattern warnings\n",
+               correlation.pairs, correlation.voltage_warnings, correlation.temperature_warnings,
+               correlation.pattern_warnings);
+    }
 
     printf("\n4. Optimized Batch Processing:\n");
-    optimized_batch_processing();
+    optimized_batch_processing(fleet, scheduler);
+
+    printf("\n5. Delta Register Scanning:\n");
+    int max_changes = fleet->num_chips * MAX_REGISTERS_PER_CHIP;
+    register_change_t *changes = malloc((size_t)max_changes * sizeof(register_change_t));
+    int changed = scan_all_chips_registers_delta(fleet, changes, (changes != NULL) ? max_changes : 0);
+    printf("Changed registers: %d\n", changed);
+    free(changes);
+
+    printf("\n6. Fleet Status Evaluation:\n");
+    evaluate_fleet_status(fleet);
+
+    printf("\n7. Address-Indexed Register Updates:\n");
+    int applied = 0;
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
+        monitor_system_t *monitor = &chip_systems[chip].monitor;
+        uint32_t address = register_address(monitor, monitor->num_registers - 1);
+        applied += apply_register_update(fleet, address, register_min(monitor, 0) + (uint32_t)chip);
+    }
+    applied += apply_register_update(fleet, 0x7FFFFFF0u, 0);  // Unmapped address is ignored
+    printf("Applied register updates: %d\n", applied);
 
     // Performance statistics
     printf("\n=== Performance Statistics ===\n");
@@ -346,13 +1102,13 @@ int multi_chip_monitoring(int num_chips) {
     int total_valid = 0;
     int total_errors = 0;
 
-    for (int chip = 0; chip < active_chip_count; chip++) {
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
         total_registers += chip_systems[chip].monitor.num_registers;
         total_valid += count_valid_registers(&chip_systems[chip].monitor);
         total_errors += chip_systems[chip].monitor.error_count;
     }
 
-    printf("Total chips monitored: %d\n", active_chip_count);
+    printf("Total chips monitored: %d\n", fleet->active_chip_count);
     printf("Total registers: %d\n", total_registers);
     printf("Total valid registers: %d\n", total_valid);
     printf("Total errors detected: %d\n", total_errors);
@@ -361,9 +1117,13 @@ int multi_chip_monitoring(int num_chips) {
     printf("\n=== Homework 1 Complete ===\n");
     printf("Advanced loop patterns successfully demonstrated!\n");
 
+    destroy_task_scheduler(scheduler);
+    destroy_worker_pool(pool);
+    destroy_chip_fleet(fleet);
     return total_valid;
 }
 
+#ifdef MULTI_CHIP_MONITOR_STANDALONE
 /**
  * @brief Main function for testing
  */
@@ -380,4 +1140,4 @@ int main(void) {
 
     return 0;
 }
-
+#endif
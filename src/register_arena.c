@@ -0,0 +1,98 @@
+/**
+ * @file register_arena.c
+ * @brief Bump allocator backing the register stores
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "monitor.h"
+
+struct register_arena_block {
+    register_arena_block_t *next;
+    size_t size;  // Usable bytes in data
+    size_t used;
+    _Alignas(REGISTER_ARENA_ALIGN) unsigned char data[];
+};
+
+// Arena for data that lives as long as the process (compiled register-map field checks)
+static register_arena_t process_arena = {NULL, REGISTER_ARENA_DEFAULT_BLOCK, 0};
+
+/**
+ * @brief Prepare an empty arena
+ * @param arena Arena to initialize
+ * @param block_size Minimum size of the blocks taken from the heap (0 for the default)
+ */
+void register_arena_init(register_arena_t *arena, size_t block_size) {
+    if (arena == NULL) {
+        return;
+    }
+
+    arena->blocks = NULL;
+    arena->block_size = (block_size > 0) ? block_size : REGISTER_ARENA_DEFAULT_BLOCK;
+    arena->used = 0;
+}
+
+/**
+ * @brief Allocate zeroed, cache-line aligned memory from an arena
+ * @param arena Arena to allocate from
+ * @param size Number of bytes
+ * @return Pointer to the memory, or NULL if arena is NULL or the heap is exhausted
+ */
+void *register_arena_alloc(register_arena_t *arena, size_t size) {
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    size = (size + REGISTER_ARENA_ALIGN - 1) & ~(size_t)(REGISTER_ARENA_ALIGN - 1);
+
+    register_arena_block_t *block = arena->blocks;
+    if (block == NULL || block->size - block->used < size) {
+        size_t capacity = (size > arena->block_size) ? size : arena->block_size;
+        block = aligned_alloc(REGISTER_ARENA_ALIGN,
+                              (sizeof(*block) + capacity + REGISTER_ARENA_ALIGN - 1) &
+                              ~(size_t)(REGISTER_ARENA_ALIGN - 1));
+        if (block == NULL) {
+            return NULL;
+        }
+        block->next = arena->blocks;
+        block->size = capacity;
+        block->used = 0;
+        arena->blocks = block;
+    }
+
+    void *memory = block->data + block->used;
+    block->used += size;
+    arena->used += size;
+    memset(memory, 0, size);
+    return memory;
+}
+
+/**
+ * @brief Release every allocation of an arena at once
+ * @param arena Arena to reset
+ *
+ * Every system whose register store came from the arena must be
+ * re-initialized before it is used again.
+ */
+void register_arena_reset(register_arena_t *arena) {
+    if (arena == NULL) {
+        return;
+    }
+
+    register_arena_block_t *block = arena->blocks;
+    while (block != NULL) {
+        register_arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+    arena->used = 0;
+}
+
+/**
+ * @brief Arena for process-lifetime data such as compiled register-map field checks
+ * @return Process-wide arena (never reset by the monitor itself)
+ */
+register_arena_t *default_register_arena(void) {
+    return &process_arena;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file register_file.c
+ * @brief Memory-mapped register file backend
+ *
+ * Backs the 0x40000000 register space with an mmap'd file or POSIX shared
+ * memory object, standing in for a device BAR. Once attached, register
+ * reads and writes are plain loads and stores into the mapping, so an
+ * external simulator process can drive register contents.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "monitor.h"
+
+/**
+ * @brief Currently attached register window
+ */
+static volatile uint32_t *reg_window = NULL;
+static size_t reg_window_size = 0;
+static char reg_window_path[256] = "";
+
+/**
+ * @brief Map an open descriptor as the register window
+ * @param fd File descriptor to map (closed by this function)
+ * @param size Window size in bytes (0 maps the whole file, at least REGISTER_FILE_DEFAULT_SIZE)
+ * @param path Filesystem path of the backing file
+ * @return true if the window was mapped, false otherwise
+ *
+ * The file is only ever grown to the window size, never shrunk: another
+ * process (an external simulator) may have it mapped at its own size.
+ */
+static bool map_register_window(int fd, size_t size, const char *path) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror("fstat");
+        close(fd);
+        return false;
+    }
+
+    size_t file_size = (size_t)st.st_size;
+    if (size == 0) {
+        size = (file_size > REGISTER_FILE_DEFAULT_SIZE) ? file_size : REGISTER_FILE_DEFAULT_SIZE;
+    }
+    if (file_size < size && ftruncate(fd, (off_t)size) != 0) {
+        perror("ftruncate");
+        close(fd);
+        return false;
+    }
+
+    void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps its own reference
+
+    if (mapping == MAP_FAILED) {
+        perror("mmap");
+        return false;
+    }
+
+    detach_register_file();
+    reg_window = (volatile uint32_t *)mapping;
+    reg_window_size = size;
+    snprintf(reg_window_path, sizeof(reg_window_path), "%s", path);
+    return true;
+}
+
+/**
+ * @brief Back the register space with a regular file
+ * @param path File to map; created if it does not exist
+ * @param size Window size in bytes (0 maps the whole file, at least REGISTER_FILE_DEFAULT_SIZE)
+ * @return true if the file was attached, false otherwise
+ */
+bool attach_register_file(const char *path, size_t size) {
+    if (path == NULL) {
+        return false;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        perror("open");
+        return false;
+    }
+
+    return map_register_window(fd, size, path);
+}
+
+/**
+ * @brief Back the register space with a POSIX shared memory object
+ * @param name Object name such as "/monitor_regs" (lives in /dev/shm)
+ * @param size Window size in bytes (0 maps the whole object, at least REGISTER_FILE_DEFAULT_SIZE)
+ * @return true if the object was attached, false otherwise
+ */
+bool attach_register_shm(const char *name, size_t size) {
+    if (name == NULL) {
+        return false;
+    }
+
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        perror("shm_open");
+        return false;
+    }
+
+    // POSIX shared memory objects live under /dev/shm on Linux
+    char path[256];
+    snprintf(path, sizeof(path), "/dev/shm%s", name);
+    return map_register_window(fd, size, path);
+}
+
+/**
+ * @brief Grow the attached register window to cover an address range
+ * @param end One past the highest register address that must be mapped
+ * @return true if the window covers end (or no window is attached)
+ *
+ * The backing file is remapped at the larger size, so pointers into the
+ * old mapping must not be in use.
+ */
+bool reserve_register_file(uint32_t end) {
+    if (reg_window == NULL || end <= REGISTER_FILE_BASE ||
+        (size_t)(end - REGISTER_FILE_BASE) <= reg_window_size) {
+        return true;
+    }
+
+    char path[sizeof(reg_window_path)];
+    snprintf(path, sizeof(path), "%s", reg_window_path);
+    return attach_register_file(path, (size_t)(end - REGISTER_FILE_BASE));
+}
+
+/**
+ * @brief Unmap the register window and return to simulated registers
+ */
+void detach_register_file(void) {
+    if (reg_window != NULL) {
+        munmap((void *)reg_window, reg_window_size);
+        reg_window = NULL;
+        reg_window_size = 0;
+        reg_window_path[0] = '\0';
+    }
+}
+
+/**
+ * @brief Get the filesystem path backing the register window
+ * @return Path of the attached file, or NULL if nothing is attached
+ */
+const char *register_file_path(void) {
+    return reg_window != NULL ? reg_window_path : NULL;
+}
+
+/**
+ * @brief Get the size of the attached register window
+ * @return Window size in bytes, or 0 if nothing is attached
+ */
+size_t register_file_size(void) {
+    return reg_window_size;
+}
+
+/**
+ * @brief Check whether a register window is attached
+ * @return true if reads and writes go to the mapped file
+ */
+bool register_file_attached(void) {
+    return reg_window != NULL;
+}
+
+/**
+ * @brief Load a register from the mapped window
+ * @param address Register address
+ * @param value Receives the register contents
+ * @return true if the address lies inside the attached window
+ */
+bool register_file_read(uint32_t address, uint32_t *value) {
+    uint32_t offset = address - REGISTER_FILE_BASE;
+
+    if (reg_window == NULL || address < REGISTER_FILE_BASE ||
+        (size_t)offset + sizeof(uint32_t) > reg_window_size || (offset & 0x3) != 0) {
+        return false;
+    }
+
+    *value = reg_window[offset / 4];
+    return true;
+}
+
+/**
+ * @brief Store a register into the mapped window
+ * @param address Register address
+ * @param value Value to store
+ * @return true if the address lies inside the attached window
+ */
+bool register_file_write(uint32_t address, uint32_t value) {
+    uint32_t offset = address - REGISTER_FILE_BASE;
+
+    if (reg_window == NULL || address < REGISTER_FILE_BASE ||
+        (size_t)offset + sizeof(uint32_t) > reg_window_size || (offset & 0x3) != 0) {
+        return false;
+    }
+
+    reg_window[offset / 4] = value;
+    return true;
+}
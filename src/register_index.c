@@ -0,0 +1,167 @@
+/**
+ * @file register_index.c
+ * @brief Constant-time address -> (chip, register) index
+ *
+ * Register addresses are split into a 4 KiB page number and a word
+ * offset. A perfect hash maps each page holding registers to its page
+ * entry, and the entry's slice of the slot table maps word offsets to
+ * the (chip, register) at that address. A lookup is one hash probe and
+ * two table loads, independent of the number of chips and registers.
+ */
+
+#include <stdlib.h>
+#include "monitor.h"
+
+#define INDEX_PAGE_SHIFT 12
+#define INDEX_WORD_MASK 0x3FFu  // Word offset within a page
+
+/**
+ * @brief One register being indexed
+ */
+typedef struct {
+    uint32_t address;
+    register_slot_t slot;
+} indexed_register_t;
+
+static int compare_indexed_register(const void *a, const void *b) {
+    const indexed_register_t *reg_a = a;
+    const indexed_register_t *reg_b = b;
+    if (reg_a->address != reg_b->address) {
+        return (reg_a->address > reg_b->address) - (reg_a->address < reg_b->address);
+    }
+    if (reg_a->slot.chip != reg_b->slot.chip) {
+        return (reg_a->slot.chip > reg_b->slot.chip) - (reg_a->slot.chip < reg_b->slot.chip);
+    }
+    return (reg_a->slot.reg > reg_b->slot.reg) - (reg_a->slot.reg < reg_b->slot.reg);
+}
+
+/**
+ * @brief Build an address index over a set of systems
+ * @param index Index to build
+ * @param arena Arena holding the index tables
+ * @param systems Systems to index; systems[i] is reported as chip i (NULL entries are skipped)
+ * @param num_systems Number of systems
+ * @return true if built, false on invalid arguments or out of memory
+ *
+ * Unaligned addresses are not indexed. If several registers share an
+ * address, the one on the lowest chip (then lowest index) wins. The
+ * index is a snapshot: rebuild it after addresses change.
+ */
+bool build_register_address_index(register_address_index_t *index, register_arena_t *arena,
+                                  const monitor_system_t *const *systems, int num_systems) {
+    if (index == NULL || arena == NULL || num_systems < 0 || (num_systems > 0 && systems == NULL)) {
+        return false;
+    }
+
+    size_t total = 0;
+    for (int chip = 0; chip < num_systems; chip++) {
+        total += (systems[chip] != NULL) ? (size_t)systems[chip]->num_registers : 0;
+    }
+
+    indexed_register_t *regs = malloc((total + 1) * sizeof(indexed_register_t));
+    uint32_t *page_keys = malloc((total + 1) * sizeof(uint32_t));
+    int32_t *page_values = malloc((total + 1) * sizeof(int32_t));
+    if (regs == NULL || page_keys == NULL || page_values == NULL) {
+        free(regs);
+        free(page_keys);
+        free(page_values);
+        return false;
+    }
+
+    size_t n = 0;
+    for (int chip = 0; chip < num_systems; chip++) {
+        const monitor_system_t *system = systems[chip];
+        for (int reg = 0; system != NULL && reg < system->num_registers; reg++) {
+            uint32_t address = register_address(system, reg);
+            if ((address & 3u) == 0) {
+                regs[n++] = (indexed_register_t){address, {chip, reg}};
+            }
+        }
+    }
+    qsort(regs, n, sizeof(indexed_register_t), compare_indexed_register);
+
+    // Size each page's slice from its lowest to its highest register
+    size_t num_pages = 0;
+    size_t num_slots = 0;
+    for (size_t i = 0; i < n; ) {
+        uint32_t page = regs[i].address >> INDEX_PAGE_SHIFT;
+        size_t last = i;
+        while (last + 1 < n && (regs[last + 1].address >> INDEX_PAGE_SHIFT) == page) {
+            last++;
+        }
+        num_slots += ((regs[last].address - regs[i].address) >> 2) + 1;
+        num_pages++;
+        i = last + 1;
+    }
+
+    index->pages = register_arena_alloc(arena, (num_pages + 1) * sizeof(register_index_page_t));
+    index->slots = register_arena_alloc(arena, (num_slots + 1) * sizeof(register_slot_t));
+    index->num_pages = num_pages;
+    bool built = (index->pages != NULL && index->slots != NULL);
+
+    if (built) {
+        for (size_t s = 0; s < num_slots; s++) {
+            index->slots[s] = (register_slot_t){-1, -1};
+        }
+
+        size_t page_index = 0;
+        uint32_t next_slot = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t page = regs[i].address >> INDEX_PAGE_SHIFT;
+            uint32_t word = (regs[i].address >> 2) & INDEX_WORD_MASK;
+
+            if (i == 0 || page != (regs[i - 1].address >> INDEX_PAGE_SHIFT)) {
+                register_index_page_t *entry = &index->pages[page_index];
+                entry->first_word = (uint16_t)word;
+                entry->words = 0;
+                entry->first_slot = next_slot;
+                page_keys[page_index] = page;
+                page_values[page_index] = (int32_t)page_index;
+                page_index++;
+            }
+
+            register_index_page_t *entry = &index->pages[page_index - 1];
+            uint32_t offset = word - entry->first_word;
+            entry->words = (uint16_t)(offset + 1);
+            next_slot = entry->first_slot + offset + 1;
+            if (index->slots[entry->first_slot + offset].chip < 0) {
+                index->slots[entry->first_slot + offset] = regs[i].slot;
+            }
+        }
+
+        built = register_phash_build(&index->page_hash, arena, page_keys, page_values, num_pages);
+    }
+
+    free(regs);
+    free(page_keys);
+    free(page_values);
+    return built;
+}
+
+/**
+ * @brief Resolve a register address
+ * @param index Built address index
+ * @param address Register address
+ * @param slot Receives the chip and register index
+ * @return true if a register has that address
+ */
+bool find_register_by_address(const register_address_index_t *index, uint32_t address,
+                              register_slot_t *slot) {
+    if (index == NULL || slot == NULL || (address & 3u) != 0) {
+        return false;
+    }
+
+    int32_t page = register_phash_lookup(&index->page_hash, address >> INDEX_PAGE_SHIFT);
+    if (page < 0) {
+        return false;
+    }
+
+    const register_index_page_t *entry = &index->pages[page];
+    uint32_t offset = ((address >> 2) & INDEX_WORD_MASK) - entry->first_word;
+    if (offset >= entry->words) {  // Also catches words below first_word
+        return false;
+    }
+
+    *slot = index->slots[entry->first_slot + offset];
+    return slot->chip >= 0;
+}
@@ -40,14 +40,10 @@
  * - Use printf with format: "PASS: Voltage within range: %.2fV\n"
  */
 bool validate_voltage_range(float voltage) {
-    if (voltage >= MIN_VOLTAGE && voltage <= MAX_VOLTAGE) {
-        printf("PASS: Voltage within range: %.2fV\n", voltage);
-        return true;
-    } else {
-        printf("FAIL: Voltage out of range: %.2fV (expected %.2f-%.2fV)\n",
-               voltage, MIN_VOLTAGE, MAX_VOLTAGE);
-        return false;
-    }
+    bool voltage_ok = (voltage >= MIN_VOLTAGE && voltage <= MAX_VOLTAGE);
+
+    report_sensor(REPORT_VOLTAGE_CHECK, voltage_ok ? REPORT_PASS : REPORT_FAIL, voltage);
+    return voltage_ok;
 }
 
 /**
@@ -63,15 +59,13 @@ bool validate_voltage_range(float voltage) {
  */
 bool validate_temperature_range(float temperature) {
     if (temperature > TEMP_CRITICAL) {
-        printf("FAIL: Temperature critical: %.1f°C (max %.1f°C)\n",
-               temperature, TEMP_CRITICAL);
+        report_sensor(REPORT_TEMPERATURE_CHECK, REPORT_FAIL, temperature);
         return false;
     } else if (temperature > TEMP_WARNING) {
-        printf("PASS: Temperature warning: %.1f°C (warning threshold %.1f°C)\n",
-               temperature, TEMP_WARNING);
+        report_sensor(REPORT_TEMPERATURE_CHECK, REPORT_WARN, temperature);
         return true;
     } else {
-        printf("PASS: Temperature normal: %.1f°C\n", temperature);
+        report_sensor(REPORT_TEMPERATURE_CHECK, REPORT_PASS, temperature);
         return true;
     }
 }
@@ -96,12 +90,7 @@ system_status_t determine_system_status(float voltage, float temperature, float
     bool temp_ok = validate_temperature_range(temperature);
     bool current_ok = (current >= MIN_CURRENT && current <= MAX_CURRENT);
 
-    if (current_ok) {
-        printf("PASS: Current within range: %.2fA\n", current);
-    } else {
-        printf("FAIL: Current out of range: %.2fA (expected %.2f-%.2fA)\n",
-               current, MIN_CURRENT, MAX_CURRENT);
-    }
+    report_sensor(REPORT_CURRENT_CHECK, current_ok ? REPORT_PASS : REPORT_FAIL, current);
 
     if (!voltage_ok || !temp_ok || !current_ok) {
         return STATUS_CRITICAL;
@@ -233,14 +222,21 @@ void continuous_monitoring_loop(monitor_system_t *system, int duration_seconds)
 }
 
 int count_valid_registers(const monitor_system_t *system) {
-    // TODO: Implement register counting
-    (void)system;
-    return 0;
+    if (system == NULL) {
+        return 0;
+    }
+
+    // Validity is a bitmap, so counting is one popcount per 64 registers
+    return count_register_bits(system->regs.valid, system->num_registers);
 }
 
 void update_all_registers(monitor_system_t *system) {
-    // TODO: Implement register updates
-    (void)system;
+    if (system == NULL) {
+        return;
+    }
+
+    // One bulk read refreshes the whole register set
+    read_system_registers_bulk(system);
 }
 
 void handle_error(error_code_t error_code) {
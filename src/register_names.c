@@ -0,0 +1,419 @@
+/**
+ * @file register_names.c
+ * @brief Interned register name table and per-system name lookup
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "monitor.h"
+
+// Characters taken from the name arena at a time
+#define NAME_POOL_CHUNK 4096
+
+/**
+ * @brief One interned name
+ */
+typedef struct {
+    const char *name;
+    uint32_t hash;
+    register_symbol_t base;  // Name a chip name was derived from (itself otherwise)
+    int32_t chip;            // Chip of a derived name, -1 otherwise
+} symbol_entry_t;
+
+/**
+ * @brief Cached chip name of a (chip, base symbol) pair
+ */
+typedef struct {
+    uint64_t key;  // (chip << 32) | base, 0 if the slot is empty
+    register_symbol_t symbol;
+} derived_slot_t;
+
+static symbol_entry_t *symbols;
+static size_t symbol_count;
+static size_t symbol_capacity;
+
+// Open-addressed name -> symbol table (symbol + 1, 0 if the slot is empty)
+static uint32_t *name_slots;
+static size_t name_slot_count;
+
+static derived_slot_t *derived_slots;
+static size_t derived_slot_count;
+static size_t derived_count;
+
+// Name characters; never freed, so symbol names stay valid for the process
+static register_arena_t name_arena = {NULL, REGISTER_ARENA_DEFAULT_BLOCK, 0};
+static char *name_pool;
+static size_t name_pool_left;
+
+/**
+ * @brief FNV-1a hash of a name's first len characters
+ */
+static uint32_t name_hash(const char *name, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Length of a name as stored (at most REGISTER_NAME_LENGTH - 1 characters)
+ */
+static size_t stored_length(const char *name) {
+    size_t len = 0;
+    while (len < REGISTER_NAME_LENGTH - 1 && name[len] != '\0') {
+        len++;
+    }
+    return len;
+}
+
+/**
+ * @brief Find the slot of a name, or the empty slot where it belongs
+ */
+static size_t find_name_slot(const char *name, size_t len, uint32_t hash) {
+    size_t mask = name_slot_count - 1;
+    size_t slot = hash & mask;
+
+    while (name_slots[slot] != 0) {
+        const symbol_entry_t *entry = &symbols[name_slots[slot] - 1];
+        if (entry->hash == hash && strncmp(entry->name, name, len) == 0 && entry->name[len] == '\0') {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief Double the name table
+ * @return false if out of memory
+ */
+static bool grow_name_slots(void) {
+    size_t count = (name_slot_count > 0) ? 2 * name_slot_count : 64;
+    uint32_t *slots = calloc(count, sizeof(uint32_t));
+    if (slots == NULL) {
+        return false;
+    }
+
+    free(name_slots);
+    name_slots = slots;
+    name_slot_count = count;
+    for (size_t s = 0; s < symbol_count; s++) {
+        const symbol_entry_t *entry = &symbols[s];
+        name_slots[find_name_slot(entry->name, strlen(entry->name), entry->hash)] = (uint32_t)s + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Copy a name into the pool
+ * @return Stored copy, or NULL if out of memory
+ */
+static const char *store_name(const char *name, size_t len) {
+    if (name_pool_left < len + 1) {
+        name_pool = register_arena_alloc(&name_arena, NAME_POOL_CHUNK);
+        if (name_pool == NULL) {
+            name_pool_left = 0;
+            return NULL;
+        }
+        name_pool_left = NAME_POOL_CHUNK;
+    }
+
+    char *copy = name_pool;
+    memcpy(copy, name, len);
+    copy[len] = '\0';
+    name_pool += len + 1;
+    name_pool_left -= len + 1;
+    return copy;
+}
+
+/**
+ * @brief Intern a register name
+ * @param name Name to intern (truncated to REGISTER_NAME_LENGTH - 1 characters)
+ * @return Symbol of the name, or REGISTER_SYMBOL_NONE if name is NULL or out of memory
+ *
+ * Interning the same name again returns the same symbol.
+ */
+register_symbol_t intern_register_name(const char *name) {
+    if (name == NULL) {
+        return REGISTER_SYMBOL_NONE;
+    }
+
+    // Symbol 0 is reserved for the empty name
+    if (symbol_count == 0 && name[0] != '\0' && intern_register_name("") != REGISTER_SYMBOL_EMPTY) {
+        return REGISTER_SYMBOL_NONE;
+    }
+
+    size_t len = stored_length(name);
+    uint32_t hash = name_hash(name, len);
+    if (name_slot_count > 0) {
+        size_t slot = find_name_slot(name, len, hash);
+        if (name_slots[slot] != 0) {
+            return name_slots[slot] - 1;
+        }
+    }
+
+    // Keep the table at most half full
+    if (2 * (symbol_count + 1) > name_slot_count && !grow_name_slots()) {
+        return REGISTER_SYMBOL_NONE;
+    }
+    if (symbol_count == symbol_capacity) {
+        size_t capacity = (symbol_capacity > 0) ? 2 * symbol_capacity : 64;
+        symbol_entry_t *grown = realloc(symbols, capacity * sizeof(symbol_entry_t));
+        if (grown == NULL) {
+            return REGISTER_SYMBOL_NONE;
+        }
+        symbols = grown;
+        symbol_capacity = capacity;
+    }
+
+    const char *copy = store_name(name, len);
+    if (copy == NULL) {
+        return REGISTER_SYMBOL_NONE;
+    }
+
+    register_symbol_t symbol = (register_symbol_t)symbol_count++;
+    symbols[symbol] = (symbol_entry_t){copy, hash, symbol, -1};
+    name_slots[find_name_slot(copy, len, hash)] = symbol + 1;
+    return symbol;
+}
+
+/**
+ * @brief Look up a name without interning it
+ * @param name Name to find
+ * @return Symbol of the name, or REGISTER_SYMBOL_NONE if it was never interned
+ */
+register_symbol_t find_register_symbol(const char *name) {
+    if (name == NULL || name_slot_count == 0) {
+        return REGISTER_SYMBOL_NONE;
+    }
+
+    size_t len = stored_length(name);
+    size_t slot = find_name_slot(name, len, name_hash(name, len));
+    return (name_slots[slot] != 0) ? name_slots[slot] - 1 : REGISTER_SYMBOL_NONE;
+}
+
+/**
+ * @brief Text of a symbol
+ * @param symbol Interned symbol
+ * @return Name of the symbol ("" for an unknown symbol)
+ */
+const char *register_symbol_name(register_symbol_t symbol) {
+    return (symbol < symbol_count) ? symbols[symbol].name : "";
+}
+
+/**
+ * @brief Find the cache slot of a (chip, base) key, or the empty slot where it belongs
+ */
+static size_t find_derived_slot(uint64_t key) {
+    size_t mask = derived_slot_count - 1;
+    size_t slot = name_hash((const char *)&key, sizeof(key)) & mask;
+
+    while (derived_slots[slot].key != 0 && derived_slots[slot].key != key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief Double the chip name cache
+ * @return false if out of memory
+ */
+static bool grow_derived_slots(void) {
+    derived_slot_t *old = derived_slots;
+    size_t old_count = derived_slot_count;
+    size_t count = (old_count > 0) ? 2 * old_count : 64;
+
+    derived_slots = calloc(count, sizeof(derived_slot_t));
+    if (derived_slots == NULL) {
+        derived_slots = old;
+        return false;
+    }
+    derived_slot_count = count;
+    for (size_t s = 0; s < old_count; s++) {
+        if (old[s].key != 0) {
+            derived_slots[find_derived_slot(old[s].key)] = old[s];
+        }
+    }
+    free(old);
+    return true;
+}
+
+/**
+ * @brief Symbol of a register's name on a given chip
+ * @param chip Chip number, or -1 for the plain name
+ * @param base Symbol of the register's own name
+ * @return Symbol of "CHIP<chip>_<name>" (base itself for chip -1, an
+ *         unnamed register, a chip name too long for REGISTER_NAME_LENGTH,
+ *         or if the table is out of memory)
+ *
+ * The chip name is formatted and interned on first use only; later
+ * calls are a single cache probe. A chip name that would be truncated
+ * is never interned: two long names sharing their first characters
+ * would otherwise collapse into one symbol.
+ */
+register_symbol_t chip_register_symbol(int chip, register_symbol_t base) {
+    if (chip < 0 || base == REGISTER_SYMBOL_EMPTY || base >= symbol_count) {
+        return base;
+    }
+
+    uint64_t key = ((uint64_t)(uint32_t)chip << 32) | base;
+    if (derived_slot_count > 0) {
+        size_t slot = find_derived_slot(key);
+        if (derived_slots[slot].key == key) {
+            return derived_slots[slot].symbol;
+        }
+    }
+    if (2 * (derived_count + 1) > derived_slot_count && !grow_derived_slots()) {
+        return base;
+    }
+
+    char name[REGISTER_NAME_LENGTH];
+    int len = snprintf(name, sizeof(name), "CHIP%d_%s", chip, symbols[base].name);
+    register_symbol_t symbol = REGISTER_SYMBOL_NONE;
+    if (len > 0 && (size_t)len < sizeof(name)) {
+        symbol = intern_register_name(name);
+    }
+    if (symbol == REGISTER_SYMBOL_NONE) {
+        symbol = base;  // Cached too, so the name is not formatted again
+    }
+
+    if (symbol != base) {
+        symbols[symbol].base = base;
+        symbols[symbol].chip = chip;
+    }
+    derived_slots[find_derived_slot(key)] = (derived_slot_t){key, symbol};
+    derived_count++;
+    return symbol;
+}
+
+/**
+ * @brief Undo chip_register_symbol()
+ * @param symbol Symbol of a name
+ * @param chip Chip the name may belong to
+ * @return Base symbol if symbol is a chip name of chip, symbol itself otherwise
+ */
+register_symbol_t register_symbol_base(register_symbol_t symbol, int chip) {
+    if (chip >= 0 && symbol < symbol_count && symbols[symbol].chip == chip) {
+        return symbols[symbol].base;
+    }
+    return symbol;
+}
+
+/**
+ * @brief Number of interned names
+ */
+size_t register_symbol_count(void) {
+    return symbol_count;
+}
+
+/**
+ * @brief Order (symbol, index) pairs by symbol, then index
+ */
+static int compare_symbol_index(const void *a, const void *b) {
+    const uint32_t *pair_a = a;
+    const uint32_t *pair_b = b;
+    if (pair_a[0] != pair_b[0]) {
+        return (pair_a[0] > pair_b[0]) - (pair_a[0] < pair_b[0]);
+    }
+    return (pair_a[1] > pair_b[1]) - (pair_a[1] < pair_b[1]);
+}
+
+/**
+ * @brief Rebuild a system's name index from its register names
+ * @return false if out of memory
+ *
+ * Unnamed registers are left out; a name used twice finds its first register.
+ */
+static bool build_register_name_index(monitor_system_t *system) {
+    size_t n = (size_t)system->num_registers;
+    register_arena_reset(&system->name_index_arena);  // Drops the previous index's tables
+    uint32_t *pairs = malloc((n + 1) * 2 * sizeof(uint32_t));
+    uint32_t *keys = malloc((n + 1) * sizeof(uint32_t));
+    int32_t *values = malloc((n + 1) * sizeof(int32_t));
+    bool built = (pairs != NULL && keys != NULL && values != NULL);
+
+    if (built) {
+        for (size_t i = 0; i < n; i++) {
+            pairs[2 * i] = system->name_ids[i];
+            pairs[2 * i + 1] = (uint32_t)i;
+        }
+        qsort(pairs, n, 2 * sizeof(uint32_t), compare_symbol_index);
+
+        size_t distinct = 0;
+        for (size_t i = 0; i < n; i++) {
+            bool named = (pairs[2 * i] != REGISTER_SYMBOL_EMPTY);
+            if (named && (i == 0 || pairs[2 * i] != pairs[2 * (i - 1)])) {
+                keys[distinct] = pairs[2 * i];
+                values[distinct] = (int32_t)pairs[2 * i + 1];
+                distinct++;
+            }
+        }
+        built = register_phash_build(&system->name_index, &system->name_index_arena, keys, values,
+                                     distinct);
+    }
+
+    free(pairs);
+    free(keys);
+    free(values);
+    system->name_index_stale = !built;
+    return built;
+}
+
+/**
+ * @brief Strip a chip's "CHIP<n>_" prefix from a name
+ * @return Name after the prefix, or NULL if name does not carry chip's prefix
+ */
+static const char *strip_chip_prefix(const char *name, int chip) {
+    if (chip < 0) {
+        return NULL;
+    }
+
+    char prefix[REGISTER_NAME_LENGTH];
+    int len = snprintf(prefix, sizeof(prefix), "CHIP%d_", chip);
+    return (strncmp(name, prefix, (size_t)len) == 0) ? name + len : NULL;
+}
+
+/**
+ * @brief Register index of a name symbol in a built name index
+ */
+static int lookup_register_symbol(const monitor_system_t *system, register_symbol_t symbol) {
+    if (symbol == REGISTER_SYMBOL_NONE || symbol == REGISTER_SYMBOL_EMPTY) {
+        return -1;
+    }
+    return register_phash_lookup(&system->name_index, symbol);
+}
+
+/**
+ * @brief Find a register by name
+ * @param system Pointer to monitor system structure
+ * @param name Register name, with or without the system's chip prefix
+ * @return Register index, or -1 if no register has that name
+ *
+ * Names are resolved to their symbol and looked up in a perfect hash
+ * over the system's register names, which is rebuilt on the first
+ * lookup after a register is renamed. A "CHIP<n>_" prefix matching the
+ * system's chip is stripped first, so chip names resolve without ever
+ * having been formatted.
+ */
+int find_register_by_name(monitor_system_t *system, const char *name) {
+    if (system == NULL || name == NULL) {
+        return -1;
+    }
+    if (system->name_index_stale && !build_register_name_index(system)) {
+        return -1;
+    }
+
+    const char *base = strip_chip_prefix(name, system->name_chip);
+    if (base != NULL) {
+        int index = lookup_register_symbol(system, find_register_symbol(base));
+        if (index >= 0) {
+            return index;
+        }
+    }
+
+    // Registers whose own name looks like a chip name
+    register_symbol_t symbol = find_register_symbol(name);
+    return lookup_register_symbol(system, register_symbol_base(symbol, system->name_chip));
+}
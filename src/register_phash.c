@@ -0,0 +1,151 @@
+/**
+ * @file register_phash.c
+ * @brief Static perfect hash over 32-bit keys (hash and displace)
+ */
+
+#include <stdlib.h>
+#include "monitor.h"
+
+// Give up on a bucket after this many seeds (only reachable with duplicate keys)
+#define PHASH_MAX_SEED (1u << 20)
+
+/**
+ * @brief Avalanche a key with a seed (MurmurHash3 finalizer)
+ */
+static uint32_t phash_mix(uint32_t key, uint32_t seed) {
+    uint32_t h = key ^ (seed * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static uint32_t phash_bucket(const register_phash_t *phash, uint32_t key) {
+    return phash_mix(key, 0) & phash->bucket_mask;  // Slots always use a nonzero seed
+}
+
+static uint32_t phash_slot(const register_phash_t *phash, uint32_t key, uint32_t seed) {
+    return phash_mix(key, seed) & phash->slot_mask;
+}
+
+static uint32_t next_power_of_two(size_t n) {
+    uint32_t power = 1;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
+/**
+ * @brief Find a seed that places every key of a bucket in a free slot
+ * @return true if the bucket was placed
+ */
+static bool place_bucket(register_phash_t *phash, const uint32_t *keys, const int32_t *values,
+                         const uint32_t *members, uint32_t count, uint32_t *slots) {
+    for (uint32_t seed = 1; seed < PHASH_MAX_SEED; seed++) {
+        bool fits = true;
+        for (uint32_t m = 0; m < count && fits; m++) {
+            slots[m] = phash_slot(phash, keys[members[m]], seed);
+            fits = (phash->values[slots[m]] == -1);
+            for (uint32_t other = 0; other < m && fits; other++) {
+                fits = (slots[other] != slots[m]);
+            }
+        }
+        if (!fits) {
+            continue;
+        }
+
+        for (uint32_t m = 0; m < count; m++) {
+            phash->keys[slots[m]] = keys[members[m]];
+            phash->values[slots[m]] = values[members[m]];
+        }
+        phash->seeds[phash_bucket(phash, keys[members[0]])] = seed;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Build a perfect hash over a set of keys
+ * @param phash Hash to build
+ * @param arena Arena holding the hash tables
+ * @param keys Distinct keys
+ * @param values Value of each key (must not be -1)
+ * @param n Number of keys
+ * @return true if built, false on NULL arguments, duplicate keys or out of memory
+ */
+bool register_phash_build(register_phash_t *phash, register_arena_t *arena,
+                          const uint32_t *keys, const int32_t *values, size_t n) {
+    if (phash == NULL || arena == NULL || (n > 0 && (keys == NULL || values == NULL)) ||
+        n > UINT32_MAX / 2) {
+        return false;
+    }
+
+    // About four keys per bucket, at most half of the slots in use
+    uint32_t buckets = next_power_of_two((n + 3) / 4);
+    uint32_t slots = next_power_of_two(2 * n);
+    phash->bucket_mask = buckets - 1;
+    phash->slot_mask = slots - 1;
+    phash->seeds = register_arena_alloc(arena, buckets * sizeof(uint32_t));
+    phash->keys = register_arena_alloc(arena, slots * sizeof(uint32_t));
+    phash->values = register_arena_alloc(arena, slots * sizeof(int32_t));
+
+    uint32_t *bucket_start = calloc((size_t)buckets + 1, sizeof(uint32_t));
+    uint32_t *cursor = malloc(buckets * sizeof(uint32_t));
+    uint32_t *members = malloc((n + 1) * sizeof(uint32_t));
+    uint32_t *placed = malloc((n + 1) * sizeof(uint32_t));
+    bool built = (phash->seeds != NULL && phash->keys != NULL && phash->values != NULL &&
+                  bucket_start != NULL && cursor != NULL && members != NULL && placed != NULL);
+
+    if (built) {
+        for (uint32_t s = 0; s < slots; s++) {
+            phash->values[s] = -1;
+        }
+
+        // Group the keys by bucket
+        for (size_t k = 0; k < n; k++) {
+            bucket_start[phash_bucket(phash, keys[k]) + 1]++;
+        }
+        uint32_t largest = 0;
+        for (uint32_t b = 0; b < buckets; b++) {
+            largest = (bucket_start[b + 1] > largest) ? bucket_start[b + 1] : largest;
+            bucket_start[b + 1] += bucket_start[b];
+            cursor[b] = bucket_start[b];
+        }
+        for (size_t k = 0; k < n; k++) {
+            members[cursor[phash_bucket(phash, keys[k])]++] = (uint32_t)k;
+        }
+
+        // Largest buckets are placed while the table is still empty
+        for (uint32_t size = largest; size > 0 && built; size--) {
+            for (uint32_t b = 0; b < buckets && built; b++) {
+                if (bucket_start[b + 1] - bucket_start[b] == size) {
+                    built = place_bucket(phash, keys, values, members + bucket_start[b], size, placed);
+                }
+            }
+        }
+    }
+
+    free(bucket_start);
+    free(cursor);
+    free(members);
+    free(placed);
+    return built;
+}
+
+/**
+ * @brief Look up a key
+ * @param phash Built perfect hash
+ * @param key Key to find
+ * @return Value stored for key, or -1 if key is not in the set
+ */
+int32_t register_phash_lookup(const register_phash_t *phash, uint32_t key) {
+    if (phash == NULL || phash->seeds == NULL) {
+        return -1;
+    }
+
+    uint32_t slot = phash_slot(phash, key, phash->seeds[phash_bucket(phash, key)]);
+    return (phash->keys[slot] == key) ? phash->values[slot] : -1;
+}
@@ -0,0 +1,438 @@
+/**
+ * @file register_poll.c
+ * @brief Asynchronous register polling against the register file
+ *
+ * Issues reads of whole register blocks from the file backing the
+ * register window through io_uring, so that many chips can be polled
+ * with one submission and their completions reaped later. The ring is
+ * driven with raw system calls; where io_uring is unavailable the poller
+ * falls back to a synchronous pread() at submit time and the same API
+ * keeps working.
+ *
+ * The poller reads the file directly: it bypasses the register
+ * transport, so polled values are neither traced nor checked against or
+ * loaded into the shadow cache. Registers of a block that cannot be read
+ * in full are marked invalid rather than refreshed.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "monitor.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#define HAVE_IO_URING 1
+#endif
+#endif
+
+// Largest register block read in one request (one 4 KiB chip window)
+#define POLL_BLOCK_WORDS 1024
+
+/**
+ * @brief One in-flight block read
+ */
+typedef struct {
+    monitor_system_t *system;
+    uint32_t first_address;
+    uint32_t words;
+    bool in_use;
+    uint32_t block[POLL_BLOCK_WORDS];
+} poll_request_t;
+
+/**
+ * @brief Register poller state
+ */
+struct register_poller {
+    int file_fd;
+    size_t file_size;           // Size of the register window the reads must stay inside
+    unsigned depth;
+    unsigned in_flight;
+    unsigned queued;            // Prepared but not yet submitted to the kernel
+    poll_request_t *requests;
+
+#ifdef HAVE_IO_URING
+    int ring_fd;
+    void *sq_ring;
+    void *cq_ring;
+    size_t sq_ring_size;
+    size_t cq_ring_size;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+#endif
+};
+
+/**
+ * @brief Copy a completed block into its system's registers
+ * @param request Finished request
+ * @param ok false if the block could not be read in full
+ *
+ * A completed block is validated like any other register read. A failed
+ * block leaves the values alone and marks every register of the system
+ * invalid, so stale contents are not mistaken for fresh ones.
+ */
+static void complete_request(poll_request_t *request, bool ok) {
+    monitor_system_t *system = request->system;
+
+    if (ok) {
+        for (int i = 0; i < system->num_registers; i++) {
+            uint32_t word = (system->regs.addresses[i] - request->first_address) / 4;
+            system->regs.values[i] = request->block[word];
+        }
+        validate_system_registers(system);
+    } else {
+        for (int i = 0; i < system->num_registers; i++) {
+            set_register_valid(system, i, false);
+        }
+    }
+    request->in_use = false;
+}
+
+/**
+ * @brief Read a request's block synchronously
+ * @return true if the whole block was read
+ */
+static bool read_block_now(register_poller_t *poller, poll_request_t *request) {
+    size_t bytes = request->words * sizeof(uint32_t);
+    off_t offset = (off_t)(request->first_address - REGISTER_FILE_BASE);
+
+    return pread(poller->file_fd, request->block, bytes, offset) == (ssize_t)bytes;
+}
+
+#ifdef HAVE_IO_URING
+
+static int ring_setup(unsigned entries, struct io_uring_params *params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int ring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+/**
+ * @brief Create and map the submission and completion rings
+ * @return true if io_uring is usable
+ */
+static bool open_ring(register_poller_t *poller) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    poller->ring_fd = ring_setup(poller->depth, &params);
+    if (poller->ring_fd < 0) {
+        return false;
+    }
+
+    poller->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    poller->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && poller->cq_ring_size > poller->sq_ring_size) {
+        poller->sq_ring_size = poller->cq_ring_size;
+    }
+
+    poller->sq_ring = mmap(NULL, poller->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                           poller->ring_fd, IORING_OFF_SQ_RING);
+    if (poller->sq_ring == MAP_FAILED) {
+        close(poller->ring_fd);
+        return false;
+    }
+
+    if (single_mmap) {
+        poller->cq_ring = poller->sq_ring;
+    } else {
+        poller->cq_ring = mmap(NULL, poller->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                               poller->ring_fd, IORING_OFF_CQ_RING);
+        if (poller->cq_ring == MAP_FAILED) {
+            munmap(poller->sq_ring, poller->sq_ring_size);
+            close(poller->ring_fd);
+            return false;
+        }
+    }
+
+    poller->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    poller->sqes = mmap(NULL, poller->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        poller->ring_fd, IORING_OFF_SQES);
+    if (poller->sqes == MAP_FAILED) {
+        if (!single_mmap) {
+            munmap(poller->cq_ring, poller->cq_ring_size);
+        }
+        munmap(poller->sq_ring, poller->sq_ring_size);
+        close(poller->ring_fd);
+        return false;
+    }
+
+    char *sq = poller->sq_ring;
+    char *cq = poller->cq_ring;
+    poller->sq_head = (unsigned *)(sq + params.sq_off.head);
+    poller->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    poller->sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+    poller->sq_array = (unsigned *)(sq + params.sq_off.array);
+    poller->cq_head = (unsigned *)(cq + params.cq_off.head);
+    poller->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    poller->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+    poller->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    return true;
+}
+
+static void close_ring(register_poller_t *poller) {
+    if (poller->ring_fd < 0) {
+        return;
+    }
+
+    munmap(poller->sqes, poller->sqes_size);
+    if (poller->cq_ring != poller->sq_ring) {
+        munmap(poller->cq_ring, poller->cq_ring_size);
+    }
+    munmap(poller->sq_ring, poller->sq_ring_size);
+    close(poller->ring_fd);
+    poller->ring_fd = -1;
+}
+
+/**
+ * @brief Place a read for a request on the submission ring
+ */
+static void queue_ring_read(register_poller_t *poller, unsigned slot) {
+    poll_request_t *request = &poller->requests[slot];
+    unsigned tail = *poller->sq_tail;
+    unsigned index = tail & *poller->sq_mask;
+
+    struct io_uring_sqe *sqe = &poller->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = poller->file_fd;
+    sqe->addr = (uint64_t)(uintptr_t)request->block;
+    sqe->len = request->words * sizeof(uint32_t);
+    sqe->off = request->first_address - REGISTER_FILE_BASE;
+    sqe->user_data = slot;
+
+    poller->sq_array[index] = index;
+    __atomic_store_n(poller->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    poller->queued++;
+}
+
+/**
+ * @brief Consume every available completion
+ * @return Number of requests completed
+ */
+static int drain_completions(register_poller_t *poller) {
+    int completed = 0;
+    unsigned head = *poller->cq_head;
+
+    while (head != __atomic_load_n(poller->cq_tail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe *cqe = &poller->cqes[head & *poller->cq_mask];
+        poll_request_t *request = &poller->requests[cqe->user_data];
+
+        // Short or failed reads are retried synchronously once
+        bool ok = cqe->res == (int)(request->words * sizeof(uint32_t)) ||
+                  read_block_now(poller, request);
+        complete_request(request, ok);
+        poller->in_flight--;
+        completed++;
+        head++;
+    }
+
+    __atomic_store_n(poller->cq_head, head, __ATOMIC_RELEASE);
+    return completed;
+}
+
+#endif // HAVE_IO_URING
+
+/**
+ * @brief Open a poller on the file backing the register window
+ * @param depth Maximum number of block reads in flight
+ * @return New poller, or NULL if no register file is attached
+ */
+register_poller_t *open_register_poller(unsigned depth) {
+    const char *path = register_file_path();
+    if (path == NULL || depth == 0) {
+        return NULL;
+    }
+
+    register_poller_t *poller = calloc(1, sizeof(*poller));
+    if (poller == NULL) {
+        return NULL;
+    }
+
+    poller->depth = depth;
+    poller->file_size = register_file_size();
+    poller->requests = calloc(depth, sizeof(poll_request_t));
+    poller->file_fd = open(path, O_RDONLY);
+    if (poller->requests == NULL || poller->file_fd < 0) {
+        perror("open_register_poller");
+        if (poller->file_fd >= 0) {
+            close(poller->file_fd);
+        }
+        free(poller->requests);
+        free(poller);
+        return NULL;
+    }
+
+#ifdef HAVE_IO_URING
+    if (!open_ring(poller)) {
+        poller->ring_fd = -1;
+    }
+#endif
+
+    return poller;
+}
+
+/**
+ * @brief Wait for outstanding reads and release the poller
+ * @param poller Poller to close (may be NULL)
+ */
+void close_register_poller(register_poller_t *poller) {
+    if (poller == NULL) {
+        return;
+    }
+
+    register_poller_reap(poller, true);
+#ifdef HAVE_IO_URING
+    close_ring(poller);
+#endif
+    close(poller->file_fd);
+    free(poller->requests);
+    free(poller);
+}
+
+/**
+ * @brief Check whether the poller overlaps reads through io_uring
+ * @param poller Poller to query
+ * @return false if reads fall back to synchronous pread()
+ */
+bool register_poller_is_async(const register_poller_t *poller) {
+#ifdef HAVE_IO_URING
+    return poller != NULL && poller->ring_fd >= 0;
+#else
+    (void)poller;
+    return false;
+#endif
+}
+
+/**
+ * @brief Queue a read of a system's whole register block
+ * @param poller Poller to queue on
+ * @param system System whose register values are refreshed on completion
+ * @return true if the read was queued (or completed synchronously)
+ *
+ * Systems with a register outside the attached window, or spanning more
+ * than one 4 KiB block, are rejected. If a synchronous read fails the
+ * system's registers are marked invalid and false is returned.
+ *
+ * Reads are only handed to the kernel by register_poller_kick() or
+ * register_poller_reap(), so several chips can be queued and submitted
+ * as one batch.
+ */
+bool register_poller_submit(register_poller_t *poller, monitor_system_t *system) {
+    if (poller == NULL || system == NULL || system->num_registers == 0 ||
+        poller->in_flight == poller->depth) {
+        return false;
+    }
+
+    uint32_t first = system->regs.addresses[0];
+    uint32_t last = first;
+    for (int i = 1; i < system->num_registers; i++) {
+        uint32_t address = system->regs.addresses[i];
+        first = (address < first) ? address : first;
+        last = (address > last) ? address : last;
+    }
+
+    uint32_t words = (last - first) / 4 + 1;
+    if (first < REGISTER_FILE_BASE || words > POLL_BLOCK_WORDS ||
+        (size_t)(last - REGISTER_FILE_BASE) + sizeof(uint32_t) > poller->file_size) {
+        return false;
+    }
+
+    unsigned slot = 0;
+    while (poller->requests[slot].in_use) {
+        slot++;
+    }
+
+    poll_request_t *request = &poller->requests[slot];
+    request->system = system;
+    request->first_address = first;
+    request->words = words;
+    request->in_use = true;
+
+#ifdef HAVE_IO_URING
+    if (poller->ring_fd >= 0) {
+        queue_ring_read(poller, slot);
+        poller->in_flight++;
+        return true;
+    }
+#endif
+
+    // Synchronous fallback
+    bool ok = read_block_now(poller, request);
+    complete_request(request, ok);
+    return ok;
+}
+
+/**
+ * @brief Hand every queued read to the kernel without waiting
+ * @param poller Poller to kick
+ */
+void register_poller_kick(register_poller_t *poller) {
+#ifdef HAVE_IO_URING
+    if (poller != NULL && poller->ring_fd >= 0 && poller->queued > 0) {
+        int submitted = ring_enter(poller->ring_fd, poller->queued, 0, 0);
+        if (submitted > 0) {
+            poller->queued -= (unsigned)submitted;
+        }
+    }
+#else
+    (void)poller;
+#endif
+}
+
+/**
+ * @brief Collect completed block reads
+ * @param poller Poller to reap
+ * @param wait true to block until every outstanding read has completed
+ * @return Number of block reads completed by this call
+ */
+int register_poller_reap(register_poller_t *poller, bool wait) {
+    if (poller == NULL) {
+        return 0;
+    }
+
+#ifdef HAVE_IO_URING
+    if (poller->ring_fd < 0) {
+        return 0;
+    }
+
+    int completed = 0;
+    do {
+        unsigned min_complete = (wait && poller->in_flight > 0) ? 1 : 0;
+        if (poller->queued > 0 || min_complete > 0) {
+            int submitted = ring_enter(poller->ring_fd, poller->queued, min_complete,
+                                       min_complete > 0 ? IORING_ENTER_GETEVENTS : 0);
+            if (submitted < 0 && errno != EINTR) {
+                break;
+            }
+            if (submitted > 0) {
+                poller->queued -= (unsigned)submitted;
+            }
+        }
+        completed += drain_completions(poller);
+    } while (wait && poller->in_flight > 0);
+
+    return completed;
+#else
+    (void)wait;
+    return 0;
+#endif
+}
@@ -0,0 +1,238 @@
+/**
+ * @file register_transport.c
+ * @brief Register transport backends and run-time backend selection
+ *
+ * Provides the simulated and memory-mapped file backends and picks the
+ * process-wide default transport from the MONITOR_TRANSPORT environment
+ * variable ("sim", "file" or "replay"). MONITOR_TRACE_RECORD=path records
+ * every access made through the selected transport.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "monitor.h"
+
+// Environment variables consulted by select_register_transport()
+#define TRANSPORT_ENV "MONITOR_TRANSPORT"
+#define REGISTER_FILE_ENV "MONITOR_REGISTER_FILE"
+#define TRACE_FILE_ENV "MONITOR_TRACE_FILE"
+#define TRACE_RECORD_ENV "MONITOR_TRACE_RECORD"
+#define REPLAY_TIMING_ENV "MONITOR_REPLAY_TIMING"
+#define DEFAULT_REGISTER_SHM "/monitor_registers"
+
+_Thread_local uint32_t simulated_read_sequence = 0;
+
+/**
+ * @brief Process-wide default transport (NULL until first selected)
+ */
+static const register_transport_t *active_transport = NULL;
+
+/*
+ * Simulated backend
+ */
+
+static uint32_t sim_read(uint32_t address) {
+    (void)address;
+
+    simulated_read_sequence++;
+    return simulated_register_value(simulated_read_sequence);
+}
+
+static bool sim_write(uint32_t address, uint32_t value) {
+    report_register(REPORT_REGISTER_WRITE, REPORT_PASS, -1, NULL, address, value, 0);
+    return true;
+}
+
+static size_t sim_read_bulk(const uint32_t *addrs, uint32_t *out, size_t n) {
+    return simulated_read_bulk(addrs, out, n);
+}
+
+static size_t sim_write_bulk(const uint32_t *addrs, const uint32_t *values, size_t n) {
+    (void)values;
+
+    if (n == 0) {
+        return 0;
+    }
+
+    // Simulate one batched bus transaction
+    report_register(REPORT_REGISTER_BATCH_WRITE, REPORT_PASS, -1, NULL,
+                    addrs[0], (uint32_t)n, addrs[n - 1]);
+    return n;
+}
+
+const register_transport_t simulated_transport = {
+    "sim", sim_read, sim_write, sim_read_bulk, sim_write_bulk
+};
+
+/*
+ * Memory-mapped register file backend
+ *
+ * Addresses outside the attached window fall back to the simulator. The
+ * first such access is reported, since those registers then carry
+ * simulated rather than device data.
+ */
+
+static atomic_bool outside_window_reported = false;
+
+static void report_outside_window(uint32_t address) {
+    if (!atomic_exchange(&outside_window_reported, true)) {
+        printf("WARNING: Register 0x%08X is outside the %zu-byte register window, "
+               "using simulated values\n", address, register_file_size());
+    }
+}
+
+static uint32_t file_read(uint32_t address) {
+    uint32_t value;
+    if (register_file_read(address, &value)) {
+        return value;
+    }
+    report_outside_window(address);
+    return sim_read(address);
+}
+
+static bool file_write(uint32_t address, uint32_t value) {
+    if (register_file_write(address, value)) {
+        return true;
+    }
+    report_outside_window(address);
+    return sim_write(address, value);
+}
+
+static size_t file_read_bulk(const uint32_t *addrs, uint32_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = file_read(addrs[i]);
+    }
+    return n;
+}
+
+static size_t file_write_bulk(const uint32_t *addrs, const uint32_t *values, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        file_write(addrs[i], values[i]);
+    }
+    return n;
+}
+
+const register_transport_t file_transport = {
+    "file", file_read, file_write, file_read_bulk, file_write_bulk
+};
+
+/*
+ * Backend selection
+ */
+
+static const register_transport_t *const transports[] = {
+    &simulated_transport,
+    &file_transport,
+    &replay_transport,
+};
+
+/**
+ * @brief Look up a built-in transport by name
+ * @param name Backend name ("sim", "file" or "replay")
+ * @return Matching transport, or NULL if the name is unknown
+ */
+const register_transport_t *find_register_transport(const char *name) {
+    if (name == NULL) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < sizeof(transports) / sizeof(transports[0]); i++) {
+        if (strcmp(transports[i]->name, name) == 0) {
+            return transports[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Pick a transport from the environment and prepare its backing store
+ * @return Selected transport; the simulator if nothing else is usable
+ *
+ * MONITOR_TRANSPORT=file maps MONITOR_REGISTER_FILE (or the shared memory
+ * object /monitor_registers) unless a window is already attached.
+ * MONITOR_TRANSPORT=replay loads MONITOR_TRACE_FILE and replays it at
+ * full speed, or at the recorded pace if MONITOR_REPLAY_TIMING=recorded.
+ * A build with the simulated transport pinned warns about and ignores
+ * any other backend.
+ */
+const register_transport_t *select_register_transport(void) {
+    const char *name = getenv(TRANSPORT_ENV);
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    if (name != NULL && name[0] != '\0' && strcmp(name, simulated_transport.name) != 0) {
+        printf("WARNING: %s=%s ignored, simulated transport is pinned at compile time\n",
+               TRANSPORT_ENV, name);
+    }
+    return &simulated_transport;
+#else
+    if (name == NULL || name[0] == '\0') {
+        return &simulated_transport;
+    }
+
+    const register_transport_t *transport = find_register_transport(name);
+    if (transport == NULL) {
+        printf("WARNING: Unknown register transport '%s', using simulator\n", name);
+        return &simulated_transport;
+    }
+
+    if (transport == &file_transport && !register_file_attached()) {
+        const char *path = getenv(REGISTER_FILE_ENV);
+        bool attached = (path != NULL) ? attach_register_file(path, 0)
+                                       : attach_register_shm(DEFAULT_REGISTER_SHM, 0);
+        if (!attached) {
+            printf("WARNING: Register file unavailable, using simulator\n");
+            return &simulated_transport;
+        }
+    }
+
+    if (transport == &replay_transport) {
+        const char *path = getenv(TRACE_FILE_ENV);
+        if (path == NULL || !load_register_trace(path)) {
+            printf("WARNING: Register trace unavailable, using simulator\n");
+            return &simulated_transport;
+        }
+
+        const char *timing = getenv(REPLAY_TIMING_ENV);
+        if (timing != NULL && strcmp(timing, "recorded") == 0) {
+            set_register_replay_mode(REPLAY_RECORDED_TIMING);
+        }
+    }
+
+    return transport;
+#endif
+}
+
+/**
+ * @brief Finish an environment-requested trace when the program exits
+ */
+static void finish_trace_at_exit(void) {
+    stop_register_trace();
+}
+
+/**
+ * @brief Get the process-wide default transport
+ * @return Default transport, selecting one on first use
+ */
+const register_transport_t *get_register_transport(void) {
+    if (active_transport == NULL) {
+        active_transport = select_register_transport();
+
+        const char *record_path = getenv(TRACE_RECORD_ENV);
+        if (record_path != NULL && start_register_trace(record_path)) {
+            atexit(finish_trace_at_exit);
+        }
+    }
+    return active_transport;
+}
+
+/**
+ * @brief Override the process-wide default transport
+ * @param transport New default (NULL re-selects from the environment)
+ *
+ * Systems initialized afterwards, and the free read_register() and
+ * write_register() calls, use the new transport.
+ */
+void set_register_transport(const register_transport_t *transport) {
+    active_transport = transport;
+}
@@ -0,0 +1,384 @@
+/**
+ * @file register_validate.c
+ * @brief Batch register range validation
+ *
+ * Checks arrays of register values against per-register [min, max]
+ * bounds and packs the results into a validity bitmap, one bit per
+ * register. AVX2 is used when the CPU supports it, SSE2 on every other
+ * x86 CPU, and a branch-free scalar loop elsewhere.
+ *
+ * Bitfield rules are compiled into one mask/compare lane per field and
+ * checked eight fields per step with AVX2 (gather, variable shifts),
+ * clearing the validity bit of every register with a failing field.
+ */
+
+#include "monitor.h"
+#include "register_map.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_VALIDATE_SIMD 1
+#endif
+
+/**
+ * @brief Validity bits of values[0..count), count <= 64
+ */
+static uint64_t validate_word_scalar(const uint32_t *values, const uint32_t *min,
+                                     const uint32_t *max, size_t count) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t valid = (uint64_t)((values[i] >= min[i]) & (values[i] <= max[i]));
+        bits |= valid << i;
+    }
+    return bits;
+}
+
+#ifdef HAVE_VALIDATE_SIMD
+
+/**
+ * @brief Validity bits of values[0..count), count <= 64, four lanes at a time
+ *
+ * SSE2 only has signed compares, so both sides are offset by 2^31.
+ */
+__attribute__((target("sse2")))
+static uint64_t validate_word_sse2(const uint32_t *values, const uint32_t *min,
+                                   const uint32_t *max, size_t count) {
+    const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+    uint64_t bits = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(values + i)), bias);
+        __m128i lo = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(min + i)), bias);
+        __m128i hi = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(max + i)), bias);
+        __m128i invalid = _mm_or_si128(_mm_cmpgt_epi32(lo, v), _mm_cmpgt_epi32(v, hi));
+        uint64_t lanes = (uint64_t)(~_mm_movemask_ps(_mm_castsi128_ps(invalid)) & 0xF);
+        bits |= lanes << i;
+    }
+
+    if (i == count) {
+        return bits;  // Full word: a 64-bit shift by 64 would be undefined
+    }
+    return bits | (validate_word_scalar(values + i, min + i, max + i, count - i) << i);
+}
+
+/**
+ * @brief Validity bits of values[0..count), count <= 64, eight lanes at a time
+ */
+__attribute__((target("avx2")))
+static uint64_t validate_word_avx2(const uint32_t *values, const uint32_t *min,
+                                   const uint32_t *max, size_t count) {
+    uint64_t bits = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(values + i));
+        __m256i lo = _mm256_loadu_si256((const __m256i *)(min + i));
+        __m256i hi = _mm256_loadu_si256((const __m256i *)(max + i));
+        __m256i above_min = _mm256_cmpeq_epi32(_mm256_max_epu32(v, lo), v);
+        __m256i below_max = _mm256_cmpeq_epi32(_mm256_min_epu32(v, hi), v);
+        __m256i valid = _mm256_and_si256(above_min, below_max);
+        bits |= (uint64_t)(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(valid)) << i;
+    }
+
+    if (i == count) {
+        return bits;
+    }
+    return bits | (validate_word_scalar(values + i, min + i, max + i, count - i) << i);
+}
+
+#endif // HAVE_VALIDATE_SIMD
+
+typedef uint64_t (*validate_word_fn)(const uint32_t *, const uint32_t *, const uint32_t *, size_t);
+
+/**
+ * @brief Pick the widest kernel the CPU supports
+ */
+static validate_word_fn select_validate_kernel(void) {
+#ifdef HAVE_VALIDATE_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return validate_word_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return validate_word_sse2;
+    }
+#endif
+    return validate_word_scalar;
+}
+
+/**
+ * @brief Check an array of register values against per-register bounds
+ * @param values Register values
+ * @param min Inclusive lower bound of each value
+ * @param max Inclusive upper bound of each value
+ * @param n Number of registers
+ * @param valid_bitmap Receives (n + 63) / 64 words; bit i is set if value i is in range
+ * @return Number of values in range, or 0 if any pointer is NULL
+ */
+size_t validate_registers_batch(const uint32_t *values, const uint32_t *min,
+                                const uint32_t *max, size_t n, uint64_t *valid_bitmap) {
+    if (values == NULL || min == NULL || max == NULL || valid_bitmap == NULL) {
+        return 0;
+    }
+
+    validate_word_fn kernel = select_validate_kernel();
+    size_t valid = 0;
+
+    for (size_t base = 0; base < n; base += 64) {
+        size_t count = (n - base < 64) ? n - base : 64;
+        uint64_t bits = kernel(values + base, min + base, max + base, count);
+        valid_bitmap[base / 64] = bits;
+        valid += (size_t)__builtin_popcountll(bits);
+    }
+    return valid;
+}
+
+/**
+ * @brief Compile bitfield specs into mask/compare lanes
+ * @param checks Receives the compiled lanes
+ * @param arena Arena holding the lanes
+ * @param specs Field specs (a spec with reg = -1 ends the list early)
+ * @param n Number of specs
+ * @param num_registers Registers the specs may refer to
+ * @return true if compiled, false on NULL arguments, a bad spec or out of memory
+ */
+bool compile_register_fields(register_field_checks_t *checks, register_arena_t *arena,
+                             const register_field_spec_t *specs, size_t n, int num_registers) {
+    if (checks == NULL || arena == NULL || (n > 0 && specs == NULL)) {
+        return false;
+    }
+
+    size_t count = 0;
+    while (count < n && specs[count].reg >= 0) {
+        const register_field_spec_t *spec = &specs[count];
+        if (spec->reg >= num_registers || spec->width == 0 || spec->width > 31 ||
+            spec->shift + spec->width > 32 || (spec->allowed != 0 && spec->width > 5) ||
+            spec->min > spec->max) {
+            return false;
+        }
+        count++;
+    }
+
+    size_t bytes = (count + 1) * sizeof(uint32_t);
+    checks->reg = register_arena_alloc(arena, bytes);
+    checks->mask = register_arena_alloc(arena, bytes);
+    checks->shift = register_arena_alloc(arena, bytes);
+    checks->low = register_arena_alloc(arena, bytes);
+    checks->span = register_arena_alloc(arena, bytes);
+    checks->allowed = register_arena_alloc(arena, bytes);
+    checks->count = count;
+    if (checks->reg == NULL || checks->mask == NULL || checks->shift == NULL ||
+        checks->low == NULL || checks->span == NULL || checks->allowed == NULL) {
+        return false;
+    }
+
+    for (size_t k = 0; k < count; k++) {
+        const register_field_spec_t *spec = &specs[k];
+        bool is_set = (spec->allowed != 0);
+        checks->reg[k] = spec->reg;
+        checks->mask[k] = ((1u << spec->width) - 1u) << spec->shift;
+        checks->shift[k] = spec->shift;
+        checks->low[k] = is_set ? 0 : spec->min;
+        checks->span[k] = is_set ? UINT32_MAX : spec->max - spec->min;
+        checks->allowed[k] = is_set ? spec->allowed : UINT32_MAX;
+    }
+    return true;
+}
+
+/**
+ * @brief Check field lanes [begin, end) one at a time
+ * @return Number of failing fields
+ */
+static size_t validate_fields_scalar(const register_field_checks_t *checks, const uint32_t *values,
+                                     uint64_t *valid_bitmap, size_t begin, size_t end) {
+    size_t failed = 0;
+    for (size_t k = begin; k < end; k++) {
+        uint32_t field = (values[checks->reg[k]] & checks->mask[k]) >> checks->shift[k];
+        bool ok = ((field - checks->low[k]) <= checks->span[k]) &
+                  ((checks->allowed[k] >> (field & 31)) & 1u);
+        if (!ok) {
+            clear_register_bit(valid_bitmap, checks->reg[k]);
+            failed++;
+        }
+    }
+    return failed;
+}
+
+#ifdef HAVE_VALIDATE_SIMD
+
+/**
+ * @brief Check field lanes eight at a time
+ * @return Number of failing fields
+ */
+__attribute__((target("avx2")))
+static size_t validate_fields_avx2(const register_field_checks_t *checks, const uint32_t *values,
+                                   uint64_t *valid_bitmap) {
+    const __m256i index_bits = _mm256_set1_epi32(31);
+    const __m256i one = _mm256_set1_epi32(1);
+    size_t failed = 0;
+    size_t k = 0;
+
+    for (; k + 8 <= checks->count; k += 8) {
+        __m256i reg = _mm256_loadu_si256((const __m256i *)(checks->reg + k));
+        __m256i value = _mm256_i32gather_epi32((const int *)values, reg, 4);
+        __m256i field = _mm256_srlv_epi32(
+            _mm256_and_si256(value, _mm256_loadu_si256((const __m256i *)(checks->mask + k))),
+            _mm256_loadu_si256((const __m256i *)(checks->shift + k)));
+
+        __m256i offset = _mm256_sub_epi32(field, _mm256_loadu_si256((const __m256i *)(checks->low + k)));
+        __m256i span = _mm256_loadu_si256((const __m256i *)(checks->span + k));
+        __m256i in_range = _mm256_cmpeq_epi32(_mm256_min_epu32(offset, span), offset);
+
+        __m256i allowed = _mm256_srlv_epi32(_mm256_loadu_si256((const __m256i *)(checks->allowed + k)),
+                                            _mm256_and_si256(field, index_bits));
+        __m256i in_set = _mm256_cmpeq_epi32(_mm256_and_si256(allowed, one), one);
+
+        unsigned failing = ~(unsigned)_mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_and_si256(in_range, in_set))) & 0xFFu;
+        failed += (size_t)__builtin_popcount(failing);
+        while (failing != 0) {
+            clear_register_bit(valid_bitmap, checks->reg[k + (size_t)__builtin_ctz(failing)]);
+            failing &= failing - 1;
+        }
+    }
+
+    return failed + validate_fields_scalar(checks, values, valid_bitmap, k, checks->count);
+}
+
+#endif // HAVE_VALIDATE_SIMD
+
+/**
+ * @brief Apply compiled bitfield rules to a block of register values
+ * @param checks Compiled field lanes
+ * @param values Register values, indexed by register
+ * @param valid_bitmap Validity bitmap; the bit of every register with a failing field is cleared
+ * @return Number of failing fields (0 if any pointer is NULL)
+ */
+size_t validate_register_fields(const register_field_checks_t *checks, const uint32_t *values,
+                                uint64_t *valid_bitmap) {
+    if (checks == NULL || values == NULL || valid_bitmap == NULL) {
+        return 0;
+    }
+
+#ifdef HAVE_VALIDATE_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return validate_fields_avx2(checks, values, valid_bitmap);
+    }
+#endif
+    return validate_fields_scalar(checks, values, valid_bitmap, 0, checks->count);
+}
+
+/**
+ * @brief Check the bitfield rules of a single register
+ * @param checks Compiled field lanes (NULL passes)
+ * @param values Register values, indexed by register
+ * @param reg Register to check
+ * @return true if every field of reg holds an allowed value
+ *
+ * For single-register updates; whole blocks go through
+ * validate_register_fields().
+ */
+bool register_fields_valid(const register_field_checks_t *checks, const uint32_t *values, int reg) {
+    if (checks == NULL || values == NULL) {
+        return true;
+    }
+
+    for (size_t k = 0; k < checks->count; k++) {
+        if (checks->reg[k] != reg) {
+            continue;
+        }
+        uint32_t field = (values[reg] & checks->mask[k]) >> checks->shift[k];
+        if ((field - checks->low[k]) > checks->span[k] || !((checks->allowed[k] >> (field & 31)) & 1u)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Validate every register of a system in one batch
+ * @param system Pointer to monitor system structure
+ * @return Number of valid registers, or -1 if system is NULL
+ *
+ * Rebuilds the validity bitmap of the register store from the current
+ * values and bounds, which are already laid out as the kernel wants them,
+ * then applies the system's bitfield rules, if any.
+ */
+int validate_system_registers(monitor_system_t *system) {
+    if (system == NULL) {
+        return -1;
+    }
+
+    size_t valid = validate_registers_batch(system->regs.values, system->regs.min,
+                                            system->regs.max, (size_t)system->num_registers,
+                                            system->regs.valid);
+    if (system->field_checks != NULL &&
+        validate_register_fields(system->field_checks, system->regs.values, system->regs.valid) > 0) {
+        valid = (size_t)count_register_bits(system->regs.valid, system->num_registers);
+    }
+    return (int)valid;
+}
+
+/**
+ * @brief Count the set bits of a register bitmap
+ * @param bitmap Bitmap with one bit per register
+ * @param num_registers Number of registers the bitmap covers
+ * @return Number of set bits among the first num_registers (0 if bitmap is NULL)
+ */
+int count_register_bits(const uint64_t *bitmap, int num_registers) {
+    if (bitmap == NULL || num_registers <= 0) {
+        return 0;
+    }
+
+    size_t full = (size_t)num_registers / 64;
+    int count = 0;
+    for (size_t w = 0; w < full; w++) {
+        count += __builtin_popcountll(bitmap[w]);
+    }
+    if (num_registers % 64 != 0) {
+        count += __builtin_popcountll(bitmap[full] & ((1ull << (num_registers % 64)) - 1));
+    }
+    return count;
+}
+
+/**
+ * @brief Count registers whose validity differs between two systems
+ * @param a First system
+ * @param b Second system
+ * @return Number of differing registers among the registers both systems
+ *         have, or -1 if either system is NULL
+ *
+ * One XOR and one popcount per 64 registers.
+ */
+int register_validity_mismatches(const monitor_system_t *a, const monitor_system_t *b) {
+    if (a == NULL || b == NULL) {
+        return -1;
+    }
+
+    int common = (a->num_registers < b->num_registers) ? a->num_registers : b->num_registers;
+    size_t full = (size_t)common / 64;
+    int mismatches = 0;
+    for (size_t w = 0; w < full; w++) {
+        mismatches += __builtin_popcountll(a->regs.valid[w] ^ b->regs.valid[w]);
+    }
+    if (common % 64 != 0) {
+        uint64_t tail = (1ull << (common % 64)) - 1;
+        mismatches += __builtin_popcountll((a->regs.valid[full] ^ b->regs.valid[full]) & tail);
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Validate a full register map snapshot against its compile-time bounds
+ * @param values One value per register map entry, in map order
+ * @return Validity bitmap (bit i set if values[i] is in range), 0 if values is NULL
+ *
+ * The check is unrolled by the generated register_map.h, so each register
+ * costs one subtract and one compare against constants.
+ */
+uint32_t validate_register_map(const uint32_t *values) {
+    if (values == NULL) {
+        return 0;
+    }
+    return register_map_validity(values);
+}
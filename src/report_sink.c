@@ -0,0 +1,237 @@
+/**
+ * @file report_sink.c
+ * @brief Console, buffered file, binary and null reporting sinks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "monitor.h"
+
+// stdio buffer size of the buffered file sink
+#define REPORT_FILE_BUFFER_SIZE (1 << 20)
+
+/**
+ * @brief Format an event as the classic console message
+ * @param out Stream to write to
+ * @param event Event to format
+ */
+void format_report_event(FILE *out, const report_event_t *event) {
+    const char *label = (event->label != NULL) ? event->label : "?";
+
+    switch (event->type) {
+        case REPORT_VOLTAGE_CHECK:
+            if (event->outcome == REPORT_PASS) {
+                fprintf(out, "PASS: Voltage within range: %.2fV\n", event->reading);
+            } else {
+                fprintf(out, "FAIL: Voltage out of range: %.2fV (expected %.2f-%.2fV)\n",
+                        event->reading, MIN_VOLTAGE, MAX_VOLTAGE);
+            }
+            break;
+
+        case REPORT_TEMPERATURE_CHECK:
+            if (event->outcome == REPORT_FAIL) {
+                fprintf(out, "FAIL: Temperature critical: %.1f°C (max %.1f°C)\n",
+                        event->reading, TEMP_CRITICAL);
+            } else if (event->outcome == REPORT_WARN) {
+                fprintf(out, "PASS: Temperature warning: %.1f°C (warning threshold %.1f°C)\n",
+                        event->reading, TEMP_WARNING);
+            } else {
+                fprintf(out, "PASS: Temperature normal: %.1f°C\n", event->reading);
+            }
+            break;
+
+        case REPORT_CURRENT_CHECK:
+            if (event->outcome == REPORT_PASS) {
+                fprintf(out, "PASS: Current within range: %.2fA\n", event->reading);
+            } else {
+                fprintf(out, "FAIL: Current out of range: %.2fA (expected %.2f-%.2fA)\n",
+                        event->reading, MIN_CURRENT, MAX_CURRENT);
+            }
+            break;
+
+        case REPORT_REGISTER_WRITE:
+            fprintf(out, "Writing 0x%08X to register 0x%08X\n", event->value, event->address);
+            break;
+
+        case REPORT_REGISTER_BATCH_WRITE:
+            fprintf(out, "Writing %u registers in one batch (0x%08X..0x%08X)\n",
+                    event->value, event->address, event->aux);
+            break;
+
+        case REPORT_REGISTER_CHECK:
+            fprintf(out, "  %s: 0x%08X %s\n", label, event->value,
+                    event->outcome == REPORT_PASS ? "✓" : "✗");
+            break;
+
+        case REPORT_REGISTER_CHANGE:
+            fprintf(out, "  %s: 0x%08X -> 0x%08X %s\n", label, event->aux, event->value,
+                    event->outcome == REPORT_PASS ? "✓" : "✗");
+            break;
+
+        case REPORT_CHIP_SCAN_BEGIN:
+            fprintf(out, "Scanning Chip %d (Priority %u):\n", event->chip, event->value);
+            break;
+
+        case REPORT_CHIP_SCAN_END:
+            fprintf(out, "  Chip %d scan complete: %u/%u valid\n",
+                    event->chip, event->value, event->aux);
+            break;
+
+        default:
+            fprintf(out, "Unknown report event %u\n", event->type);
+            break;
+    }
+}
+
+/*
+ * Console and buffered file sinks
+ */
+
+static void text_emit(report_sink_t *sink, const report_event_t *event) {
+    format_report_event(sink->file != NULL ? sink->file : stdout, event);
+}
+
+static void text_flush(report_sink_t *sink) {
+    fflush(sink->file != NULL ? sink->file : stdout);
+}
+
+report_sink_t console_sink = {text_emit, text_flush, NULL, NULL, NULL, 0};
+
+/*
+ * Null sink: emit is NULL, so emit_report() skips the call entirely
+ */
+
+report_sink_t null_sink = {NULL, NULL, NULL, NULL, NULL, 0};
+
+/*
+ * Binary event sink
+ */
+
+static void binary_flush(report_sink_t *sink) {
+    if (sink->record_count > 0) {
+        fwrite(sink->records, sizeof(report_record_t), sink->record_count, sink->file);
+        sink->record_count = 0;
+    }
+    fflush(sink->file);
+}
+
+static void binary_emit(report_sink_t *sink, const report_event_t *event) {
+    if (sink->record_count == REPORT_BINARY_BUFFER_RECORDS) {
+        binary_flush(sink);
+    }
+
+    report_record_t *record = &sink->records[sink->record_count++];
+    record->type = event->type;
+    record->outcome = event->outcome;
+    record->chip = event->chip;
+    record->address = event->address;
+    record->value = event->value;
+    record->aux = event->aux;
+    record->reading = event->reading;
+}
+
+/*
+ * Sink management
+ */
+
+report_sink_t *active_report_sink = &console_sink;
+
+/**
+ * @brief Make a sink the destination of all reports
+ * @param sink Sink to activate (NULL restores the console sink)
+ */
+void set_report_sink(report_sink_t *sink) {
+    if (active_report_sink->flush != NULL) {
+        active_report_sink->flush(active_report_sink);
+    }
+    active_report_sink = (sink != NULL) ? sink : &console_sink;
+}
+
+/**
+ * @brief Get the active reporting sink
+ */
+report_sink_t *get_report_sink(void) {
+    return active_report_sink;
+}
+
+/**
+ * @brief Open a sink that writes console text to a file through a large buffer
+ * @param sink Sink to initialize
+ * @param path File to create
+ * @return true if the sink was opened
+ */
+bool open_file_sink(report_sink_t *sink, const char *path) {
+    if (sink == NULL || path == NULL) {
+        return false;
+    }
+
+    memset(sink, 0, sizeof(*sink));
+    sink->file = fopen(path, "w");
+    if (sink->file == NULL) {
+        perror("fopen");
+        return false;
+    }
+
+    sink->text_buffer = malloc(REPORT_FILE_BUFFER_SIZE);
+    if (sink->text_buffer != NULL) {
+        setvbuf(sink->file, sink->text_buffer, _IOFBF, REPORT_FILE_BUFFER_SIZE);
+    }
+
+    sink->emit = text_emit;
+    sink->flush = text_flush;
+    return true;
+}
+
+/**
+ * @brief Open a sink that stores fixed-size report_record_t entries
+ * @param sink Sink to initialize
+ * @param path File to create
+ * @return true if the sink was opened
+ */
+bool open_binary_sink(report_sink_t *sink, const char *path) {
+    if (sink == NULL || path == NULL) {
+        return false;
+    }
+
+    memset(sink, 0, sizeof(*sink));
+    sink->records = malloc(sizeof(report_record_t) * REPORT_BINARY_BUFFER_RECORDS);
+    if (sink->records == NULL) {
+        return false;
+    }
+
+    sink->file = fopen(path, "wb");
+    if (sink->file == NULL) {
+        perror("fopen");
+        free(sink->records);
+        sink->records = NULL;
+        return false;
+    }
+
+    sink->emit = binary_emit;
+    sink->flush = binary_flush;
+    return true;
+}
+
+/**
+ * @brief Flush and close a file or binary sink
+ * @param sink Sink to close; the console sink is restored if it was active
+ */
+void close_report_sink(report_sink_t *sink) {
+    if (sink == NULL || sink == &console_sink || sink == &null_sink) {
+        return;
+    }
+
+    if (active_report_sink == sink) {
+        set_report_sink(NULL);
+    } else if (sink->flush != NULL) {
+        sink->flush(sink);
+    }
+
+    if (sink->file != NULL) {
+        fclose(sink->file);
+    }
+    free(sink->text_buffer);
+    free(sink->records);
+    memset(sink, 0, sizeof(*sink));
+}
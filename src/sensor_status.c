@@ -0,0 +1,170 @@
+/**
+ * @file sensor_status.c
+ * @brief Branch-free sensor status classification
+ *
+ * Classifies voltage/temperature/current readings with the same rules as
+ * determine_system_status(), without reporting anything. Single readings
+ * go through a band lookup table; readings held as separate arrays (one
+ * element per chip) are classified eight chips per step with AVX2, four
+ * with SSE2, and through the lookup table for the rest.
+ */
+
+#include "monitor.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_STATUS_SIMD 1
+#endif
+
+_Static_assert(sizeof(system_status_t) == sizeof(int32_t),
+               "batch kernels store statuses as 32-bit lanes");
+
+/*
+ * Band lookup table
+ *
+ * Each reading is quantized into a band without branching: voltage and
+ * current are in range (1) or not (0), temperature is normal (0), above
+ * TEMP_WARNING (1) or above TEMP_CRITICAL (2). The three bands form an
+ * index into a 12-entry table holding the resulting status.
+ */
+
+#define BAND_INDEX(voltage_ok, current_ok, temp_band) \
+    ((voltage_ok) | ((current_ok) << 1) | ((temp_band) << 2))
+
+static const uint8_t status_band_table[12] = {
+    // Temperature normal
+    [BAND_INDEX(0, 0, 0)] = STATUS_CRITICAL, [BAND_INDEX(1, 0, 0)] = STATUS_CRITICAL,
+    [BAND_INDEX(0, 1, 0)] = STATUS_CRITICAL, [BAND_INDEX(1, 1, 0)] = STATUS_NORMAL,
+    // Temperature warning
+    [BAND_INDEX(0, 0, 1)] = STATUS_CRITICAL, [BAND_INDEX(1, 0, 1)] = STATUS_CRITICAL,
+    [BAND_INDEX(0, 1, 1)] = STATUS_CRITICAL, [BAND_INDEX(1, 1, 1)] = STATUS_WARNING,
+    // Temperature critical
+    [BAND_INDEX(0, 0, 2)] = STATUS_CRITICAL, [BAND_INDEX(1, 0, 2)] = STATUS_CRITICAL,
+    [BAND_INDEX(0, 1, 2)] = STATUS_CRITICAL, [BAND_INDEX(1, 1, 2)] = STATUS_CRITICAL,
+};
+
+/**
+ * @brief Classify one chip's readings through the band table
+ * @param voltage Voltage reading
+ * @param temperature Temperature reading
+ * @param current Current reading
+ * @return Same status as determine_system_status(), without reporting
+ *
+ * NaN readings fail every ordered comparison, exactly as in
+ * determine_system_status(): a NaN voltage or current is out of range,
+ * a NaN temperature is normal.
+ */
+system_status_t classify_system_status(float voltage, float temperature, float current) {
+    unsigned voltage_ok = (unsigned)(voltage >= MIN_VOLTAGE) & (unsigned)(voltage <= MAX_VOLTAGE);
+    unsigned current_ok = (unsigned)(current >= MIN_CURRENT) & (unsigned)(current <= MAX_CURRENT);
+    unsigned temp_band = (unsigned)(temperature > TEMP_WARNING) + (unsigned)(temperature > TEMP_CRITICAL);
+
+    return (system_status_t)status_band_table[BAND_INDEX(voltage_ok, current_ok, temp_band)];
+}
+
+static size_t classify_range_scalar(const float *voltage, const float *temperature,
+                                    const float *current, size_t begin, size_t n,
+                                    system_status_t *status) {
+    size_t critical = 0;
+    for (size_t i = begin; i < n; i++) {
+        status[i] = classify_system_status(voltage[i], temperature[i], current[i]);
+        critical += (status[i] == STATUS_CRITICAL);
+    }
+    return critical;
+}
+
+#ifdef HAVE_STATUS_SIMD
+
+__attribute__((target("sse2")))
+static size_t classify_sse2(const float *voltage, const float *temperature,
+                            const float *current, size_t n, system_status_t *status) {
+    const __m128 v_min = _mm_set1_ps(MIN_VOLTAGE), v_max = _mm_set1_ps(MAX_VOLTAGE);
+    const __m128 i_min = _mm_set1_ps(MIN_CURRENT), i_max = _mm_set1_ps(MAX_CURRENT);
+    const __m128 t_crit = _mm_set1_ps(TEMP_CRITICAL), t_warn = _mm_set1_ps(TEMP_WARNING);
+    const __m128i two = _mm_set1_epi32(STATUS_CRITICAL), one = _mm_set1_epi32(STATUS_WARNING);
+    const __m128 all_ones = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    size_t critical = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(voltage + i);
+        __m128 t = _mm_loadu_ps(temperature + i);
+        __m128 c = _mm_loadu_ps(current + i);
+
+        __m128 ok = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(v, v_min), _mm_cmple_ps(v, v_max)),
+                               _mm_and_ps(_mm_cmpge_ps(c, i_min), _mm_cmple_ps(c, i_max)));
+        __m128i crit = _mm_castps_si128(_mm_or_ps(_mm_cmpgt_ps(t, t_crit), _mm_xor_ps(ok, all_ones)));
+        __m128i warn = _mm_castps_si128(_mm_cmpgt_ps(t, t_warn));
+
+        __m128i result = _mm_or_si128(_mm_and_si128(crit, two),
+                                      _mm_andnot_si128(crit, _mm_and_si128(warn, one)));
+        _mm_storeu_si128((__m128i *)(status + i), result);
+        critical += (size_t)__builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(crit)));
+    }
+
+    return critical + classify_range_scalar(voltage, temperature, current, i, n, status);
+}
+
+__attribute__((target("avx2")))
+static size_t classify_avx2(const float *voltage, const float *temperature,
+                            const float *current, size_t n, system_status_t *status) {
+    const __m256 v_min = _mm256_set1_ps(MIN_VOLTAGE), v_max = _mm256_set1_ps(MAX_VOLTAGE);
+    const __m256 i_min = _mm256_set1_ps(MIN_CURRENT), i_max = _mm256_set1_ps(MAX_CURRENT);
+    const __m256 t_crit = _mm256_set1_ps(TEMP_CRITICAL), t_warn = _mm256_set1_ps(TEMP_WARNING);
+    const __m256i two = _mm256_set1_epi32(STATUS_CRITICAL), one = _mm256_set1_epi32(STATUS_WARNING);
+    const __m256i all_ones = _mm256_set1_epi32(-1);
+    size_t critical = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(voltage + i);
+        __m256 t = _mm256_loadu_ps(temperature + i);
+        __m256 c = _mm256_loadu_ps(current + i);
+
+        // Ordered, non-signalling predicates: NaN compares false
+        __m256 ok = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(v, v_min, _CMP_GE_OQ), _mm256_cmp_ps(v, v_max, _CMP_LE_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(c, i_min, _CMP_GE_OQ), _mm256_cmp_ps(c, i_max, _CMP_LE_OQ)));
+        __m256i crit = _mm256_or_si256(_mm256_castps_si256(_mm256_cmp_ps(t, t_crit, _CMP_GT_OQ)),
+                                       _mm256_xor_si256(_mm256_castps_si256(ok), all_ones));
+        __m256i warn = _mm256_castps_si256(_mm256_cmp_ps(t, t_warn, _CMP_GT_OQ));
+
+        __m256i result = _mm256_or_si256(_mm256_and_si256(crit, two),
+                                         _mm256_andnot_si256(crit, _mm256_and_si256(warn, one)));
+        _mm256_storeu_si256((__m256i *)(status + i), result);
+        critical += (size_t)__builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(crit)));
+    }
+
+    return critical + classify_range_scalar(voltage, temperature, current, i, n, status);
+}
+
+#endif // HAVE_STATUS_SIMD
+
+/**
+ * @brief Classify the sensor readings of many chips at once
+ * @param voltage Voltage of each chip
+ * @param temperature Temperature of each chip
+ * @param current Current of each chip
+ * @param n Number of chips
+ * @param status Receives one status per chip
+ * @return Number of chips classified STATUS_CRITICAL (0 if any pointer is NULL)
+ *
+ * status[i] equals determine_system_status(voltage[i], temperature[i],
+ * current[i]), but nothing is reported.
+ */
+size_t determine_system_status_batch(const float *voltage, const float *temperature,
+                                     const float *current, size_t n, system_status_t *status) {
+    if (voltage == NULL || temperature == NULL || current == NULL || status == NULL) {
+        return 0;
+    }
+
+#ifdef HAVE_STATUS_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return classify_avx2(voltage, temperature, current, n, status);
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return classify_sse2(voltage, temperature, current, n, status);
+    }
+#endif
+    return classify_range_scalar(voltage, temperature, current, 0, n, status);
+}
@@ -0,0 +1,250 @@
+/**
+ * @file task_scheduler.c
+ * @brief Work-stealing scheduler over the workers of a worker pool
+ *
+ * A run executes items 0..n-1 of a caller-defined task (a chip, a
+ * register block of a large chip, a row of chip pairs). Every worker
+ * owns a Chase-Lev deque of item ranges and starts with an equal slice
+ * of the items. A worker splits the range it is working on in half,
+ * pushes the upper half to the bottom of its deque and continues with
+ * the lower half, so its deque holds O(log n) ranges with the largest
+ * at the top. Workers that run dry steal the top range of a random
+ * other worker, which rebalances uneven items without any locks.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include "monitor.h"
+
+// Ranges one deque can hold; splitting in halves needs at most 33
+#define TASK_DEQUE_CAPACITY 64u
+
+/**
+ * @brief Chase-Lev deque of item ranges (begin << 32 | end)
+ *
+ * The owner pushes and takes at the bottom; thieves take at the top.
+ * Indices only grow during a run and are reset between runs.
+ */
+typedef struct {
+    _Alignas(REGISTER_ARENA_ALIGN) atomic_llong top;
+    _Alignas(REGISTER_ARENA_ALIGN) atomic_llong bottom;
+    atomic_ullong ranges[TASK_DEQUE_CAPACITY];
+} task_deque_t;
+
+struct task_scheduler {
+    worker_pool_t *pool;
+    task_deque_t *deques;  // One per worker
+    int num_workers;
+    task_fn fn;            // Task of the current run
+    void *context;
+    uint32_t num_items;
+    _Alignas(REGISTER_ARENA_ALIGN) atomic_uint remaining;  // Items not yet finished
+};
+
+static uint64_t make_range(uint32_t begin, uint32_t end) {
+    return ((uint64_t)begin << 32) | end;
+}
+
+/**
+ * @brief Push a range at the bottom (owner only)
+ * @return false if the deque is full
+ */
+static bool deque_push(task_deque_t *deque, uint64_t range) {
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (bottom - top >= (long long)TASK_DEQUE_CAPACITY) {
+        return false;
+    }
+
+    atomic_store_explicit(&deque->ranges[bottom % TASK_DEQUE_CAPACITY], range, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Take the newest range from the bottom (owner only)
+ * @return false if the deque is empty
+ */
+static bool deque_take(task_deque_t *deque, uint64_t *range) {
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+
+    *range = atomic_load_explicit(&deque->ranges[bottom % TASK_DEQUE_CAPACITY], memory_order_relaxed);
+    if (top == bottom) {
+        // Last range: race the thieves for it
+        bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                           memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+/**
+ * @brief Take the oldest range from the top (any thread)
+ * @return false if the deque was empty or another thread got there first
+ */
+static bool deque_steal(task_deque_t *deque, uint64_t *range) {
+    long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+
+    *range = atomic_load_explicit(&deque->ranges[top % TASK_DEQUE_CAPACITY], memory_order_relaxed);
+    return atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                   memory_order_seq_cst, memory_order_relaxed);
+}
+
+/**
+ * @brief Run a range, leaving its upper halves on the worker's deque for thieves
+ */
+static void run_range(task_scheduler_t *scheduler, task_deque_t *own, uint64_t range, int worker) {
+    uint32_t begin = (uint32_t)(range >> 32);
+    uint32_t end = (uint32_t)range;
+
+    while (end - begin > 1) {
+        uint32_t middle = begin + (end - begin) / 2;
+        if (!deque_push(own, make_range(middle, end))) {
+            break;  // Deque full: run the rest here
+        }
+        end = middle;
+    }
+
+    for (uint32_t item = begin; item < end; item++) {
+        scheduler->fn(scheduler->context, item, worker);
+    }
+    atomic_fetch_sub_explicit(&scheduler->remaining, end - begin, memory_order_acq_rel);
+}
+
+/**
+ * @brief Steal from randomly chosen other workers
+ * @return true if a range was stolen
+ */
+static bool steal_range(task_scheduler_t *scheduler, int worker, uint32_t *seed, uint64_t *range) {
+    for (int attempt = 1; attempt < scheduler->num_workers; attempt++) {
+        // xorshift32
+        *seed ^= *seed << 13;
+        *seed ^= *seed >> 17;
+        *seed ^= *seed << 5;
+
+        int victim = (int)(*seed % (uint32_t)(scheduler->num_workers - 1));
+        victim += (victim >= worker);  // Never the worker itself
+        if (deque_steal(&scheduler->deques[victim], range)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Worker body of a run: own slice first, then steal until every item is done
+ */
+static void scheduler_worker(void *arg, int worker, int num_workers) {
+    task_scheduler_t *scheduler = arg;
+    task_deque_t *own = &scheduler->deques[worker];
+    uint32_t begin = (uint32_t)((uint64_t)scheduler->num_items * (uint32_t)worker / (uint32_t)num_workers);
+    uint32_t end = (uint32_t)((uint64_t)scheduler->num_items * ((uint32_t)worker + 1) / (uint32_t)num_workers);
+    uint32_t seed = 2463534242u ^ ((uint32_t)worker * 0x9E3779B9u);
+
+    if (begin < end) {
+        run_range(scheduler, own, make_range(begin, end), worker);
+    }
+
+    uint64_t range;
+    while (atomic_load_explicit(&scheduler->remaining, memory_order_acquire) > 0) {
+        if (deque_take(own, &range) || steal_range(scheduler, worker, &seed, &range)) {
+            run_range(scheduler, own, range, worker);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+/**
+ * @brief Create a work-stealing scheduler over a worker pool
+ * @param pool Worker pool running the tasks (NULL runs every task inline, in order)
+ * @return New scheduler, or NULL if out of memory
+ */
+task_scheduler_t *create_task_scheduler(worker_pool_t *pool) {
+    task_scheduler_t *scheduler = aligned_alloc(REGISTER_ARENA_ALIGN, sizeof(task_scheduler_t));
+    if (scheduler == NULL) {
+        return NULL;
+    }
+
+    scheduler->pool = pool;
+    scheduler->num_workers = worker_pool_size(pool);
+    scheduler->deques = aligned_alloc(REGISTER_ARENA_ALIGN,
+                                      (size_t)scheduler->num_workers * sizeof(task_deque_t));
+    if (scheduler->deques == NULL) {
+        free(scheduler);
+        return NULL;
+    }
+    return scheduler;
+}
+
+/**
+ * @brief Release a scheduler (the worker pool is left running)
+ * @param scheduler Scheduler to destroy (NULL is ignored)
+ */
+void destroy_task_scheduler(task_scheduler_t *scheduler) {
+    if (scheduler == NULL) {
+        return;
+    }
+
+    free(scheduler->deques);
+    free(scheduler);
+}
+
+/**
+ * @brief Run a task for every item and wait for all of them
+ * @param scheduler Scheduler (NULL runs items 0..num_items-1 inline, in order, as worker 0)
+ * @param num_items Number of items
+ * @param fn Task called as fn(context, item, worker) exactly once per item
+ * @param context Argument passed to every call
+ *
+ * Items may run in any order and on any worker; fn must only write
+ * state owned by its item or by its worker. Writes made by the tasks
+ * are visible to the caller on return.
+ */
+void run_scheduled_tasks(task_scheduler_t *scheduler, uint32_t num_items, task_fn fn, void *context) {
+    if (fn == NULL || num_items == 0) {
+        return;
+    }
+    if (scheduler == NULL || scheduler->num_workers == 1) {
+        for (uint32_t item = 0; item < num_items; item++) {
+            fn(context, item, 0);
+        }
+        return;
+    }
+
+    for (int worker = 0; worker < scheduler->num_workers; worker++) {
+        atomic_init(&scheduler->deques[worker].top, 0);
+        atomic_init(&scheduler->deques[worker].bottom, 0);
+    }
+    scheduler->fn = fn;
+    scheduler->context = context;
+    scheduler->num_items = num_items;
+    atomic_init(&scheduler->remaining, num_items);
+
+    worker_pool_run(scheduler->pool, scheduler_worker, scheduler);
+}
+
+/**
+ * @brief Number of workers a scheduler runs tasks on
+ * @param scheduler Scheduler (NULL counts as a single inline worker)
+ */
+int task_scheduler_workers(const task_scheduler_t *scheduler) {
+    return (scheduler != NULL) ? scheduler->num_workers : 1;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file timer_wheel.c
+ * @brief Hierarchical timer wheel for deadline-driven scheduling
+ *
+ * Deadlines are whole ticks. Level 0 has one slot per tick for the next
+ * TIMER_WHEEL_SLOTS ticks; each higher level covers TIMER_WHEEL_SLOTS
+ * times the span of the one below. A timer sits in the lowest level
+ * whose span reaches its deadline and moves down a level whenever the
+ * wheel below it wraps around. Scheduling and cancelling are O(1), and
+ * advancing a tick costs the timers that expire or move down, however
+ * many timers the wheel holds.
+ */
+
+#include <stdlib.h>
+#include "monitor.h"
+
+#define TIMER_SLOT_MASK (TIMER_WHEEL_SLOTS - 1u)
+
+/**
+ * @brief Slot a deadline belongs to, relative to the wheel's current tick
+ */
+static uint32_t timer_slot(const timer_wheel_t *wheel, uint64_t deadline) {
+    uint64_t delta = deadline - wheel->now;
+    uint32_t level = 0;
+    while (level + 1 < TIMER_WHEEL_LEVELS && (delta >> (TIMER_WHEEL_SLOT_BITS * (level + 1))) != 0) {
+        level++;
+    }
+
+    // Beyond the top level's span a timer waits in the top level and is re-filed on each pass
+    uint64_t slot_tick = deadline;
+    if (level == TIMER_WHEEL_LEVELS - 1 &&
+        (delta >> (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) != 0) {
+        slot_tick = wheel->now + ((uint64_t)TIMER_SLOT_MASK << (TIMER_WHEEL_SLOT_BITS * level));
+    }
+    return level * TIMER_WHEEL_SLOTS +
+           (uint32_t)((slot_tick >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_SLOT_MASK);
+}
+
+/**
+ * @brief Link a timer into the slot of its deadline
+ */
+static void insert_timer(timer_wheel_t *wheel, uint32_t timer) {
+    timer_entry_t *entry = &wheel->timers[timer];
+    uint32_t slot = timer_slot(wheel, entry->deadline);
+
+    entry->slot = slot;
+    entry->prev = TIMER_NONE;
+    entry->next = wheel->slots[slot];
+    if (entry->next != TIMER_NONE) {
+        wheel->timers[entry->next].prev = timer;
+    }
+    wheel->slots[slot] = timer;
+}
+
+/**
+ * @brief Unlink a scheduled timer from its slot
+ */
+static void remove_timer(timer_wheel_t *wheel, uint32_t timer) {
+    timer_entry_t *entry = &wheel->timers[timer];
+
+    if (entry->prev != TIMER_NONE) {
+        wheel->timers[entry->prev].next = entry->next;
+    } else {
+        wheel->slots[entry->slot] = entry->next;
+    }
+    if (entry->next != TIMER_NONE) {
+        wheel->timers[entry->next].prev = entry->prev;
+    }
+    entry->slot = TIMER_NONE;
+}
+
+/**
+ * @brief Prepare an empty wheel
+ * @param wheel Wheel to initialize
+ * @param capacity Number of timers (timer ids 0..capacity-1)
+ * @return true if initialized, false on invalid arguments or out of memory
+ */
+bool timer_wheel_init(timer_wheel_t *wheel, uint32_t capacity) {
+    if (wheel == NULL || capacity == 0 || capacity == TIMER_NONE) {
+        return false;
+    }
+
+    wheel->timers = malloc((size_t)capacity * sizeof(timer_entry_t));
+    if (wheel->timers == NULL) {
+        return false;
+    }
+    for (uint32_t timer = 0; timer < capacity; timer++) {
+        wheel->timers[timer].slot = TIMER_NONE;
+    }
+    for (uint32_t slot = 0; slot < TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS; slot++) {
+        wheel->slots[slot] = TIMER_NONE;
+    }
+    wheel->capacity = capacity;
+    wheel->now = 0;
+    return true;
+}
+
+/**
+ * @brief Release a wheel's timers
+ * @param wheel Wheel to release (NULL is ignored)
+ */
+void timer_wheel_destroy(timer_wheel_t *wheel) {
+    if (wheel == NULL) {
+        return;
+    }
+
+    free(wheel->timers);
+    wheel->timers = NULL;
+    wheel->capacity = 0;
+}
+
+/**
+ * @brief Set a timer, replacing its previous deadline
+ * @param wheel Timer wheel
+ * @param timer Timer id
+ * @param deadline Tick at which the timer expires (a past tick expires on the next advance)
+ * @return true if scheduled, false on an invalid wheel or timer id
+ */
+bool timer_wheel_schedule(timer_wheel_t *wheel, uint32_t timer, uint64_t deadline) {
+    if (wheel == NULL || timer >= wheel->capacity) {
+        return false;
+    }
+
+    if (wheel->timers[timer].slot != TIMER_NONE) {
+        remove_timer(wheel, timer);
+    }
+    wheel->timers[timer].deadline = (deadline > wheel->now) ? deadline : wheel->now + 1;
+    insert_timer(wheel, timer);
+    return true;
+}
+
+/**
+ * @brief Stop a timer
+ * @param wheel Timer wheel
+ * @param timer Timer id
+ * @return true if the timer was scheduled
+ */
+bool timer_wheel_cancel(timer_wheel_t *wheel, uint32_t timer) {
+    if (wheel == NULL || timer >= wheel->capacity || wheel->timers[timer].slot == TIMER_NONE) {
+        return false;
+    }
+
+    remove_timer(wheel, timer);
+    return true;
+}
+
+/**
+ * @brief Whether a timer is scheduled
+ * @param wheel Timer wheel
+ * @param timer Timer id
+ */
+bool timer_wheel_pending(const timer_wheel_t *wheel, uint32_t timer) {
+    return wheel != NULL && timer < wheel->capacity && wheel->timers[timer].slot != TIMER_NONE;
+}
+
+/**
+ * @brief Advance the wheel and expire every timer due by a tick
+ * @param wheel Timer wheel
+ * @param tick Tick to advance to (ticks at or before the current one are a no-op)
+ * @param fn Called as fn(context, timer, deadline) for each expired timer, in deadline order
+ * @param context Argument passed to fn
+ * @return Number of timers expired
+ *
+ * An expired timer is no longer scheduled when fn runs, so fn may set it
+ * again. A timer set for the tick being expired fires on the next tick.
+ */
+size_t timer_wheel_advance(timer_wheel_t *wheel, uint64_t tick, timer_fn fn, void *context) {
+    if (wheel == NULL || fn == NULL) {
+        return 0;
+    }
+
+    size_t expired = 0;
+    while (wheel->now < tick) {
+        uint64_t now = ++wheel->now;
+
+        // Move timers down from every level whose lower wheel just wrapped, top level first
+        uint32_t top = 0;
+        while (top + 1 < TIMER_WHEEL_LEVELS &&
+               (now & ((1ull << (TIMER_WHEEL_SLOT_BITS * (top + 1))) - 1)) == 0) {
+            top++;
+        }
+        for (uint32_t level = top; level > 0; level--) {
+            uint32_t slot = level * TIMER_WHEEL_SLOTS +
+                            (uint32_t)((now >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_SLOT_MASK);
+            uint32_t timer = wheel->slots[slot];
+            wheel->slots[slot] = TIMER_NONE;
+            while (timer != TIMER_NONE) {
+                uint32_t next = wheel->timers[timer].next;
+                insert_timer(wheel, timer);
+                timer = next;
+            }
+        }
+
+        // Expire this tick's slot; it is detached first so fn can reschedule freely
+        uint32_t slot = (uint32_t)(now & TIMER_SLOT_MASK);
+        uint32_t timer = wheel->slots[slot];
+        wheel->slots[slot] = TIMER_NONE;
+        while (timer != TIMER_NONE) {
+            timer_entry_t *entry = &wheel->timers[timer];
+            uint32_t next = entry->next;
+            entry->slot = TIMER_NONE;
+            expired++;
+            fn(context, timer, entry->deadline);
+            timer = next;
+        }
+    }
+    return expired;
+}
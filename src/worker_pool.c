@@ -0,0 +1,196 @@
+/**
+ * @file worker_pool.c
+ * @brief Fork-join pool of persistent worker threads
+ *
+ * worker_pool_run() hands one task to every worker and returns once all
+ * of them have finished it. The calling thread takes part as worker 0,
+ * so a pool of one worker runs tasks inline without any thread. Threads
+ * are started once and sleep on a condition variable between runs.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "monitor.h"
+
+// Upper bound on the workers of one pool
+#define WORKER_POOL_MAX 256
+
+struct worker_pool {
+    pthread_t *threads;       // Workers 1..num_workers-1
+    int num_workers;
+    pthread_mutex_t lock;
+    pthread_cond_t start;     // Signalled when a run begins or the pool shuts down
+    pthread_cond_t done;      // Signalled when the last worker finishes a run
+    worker_task_fn task;
+    void *arg;
+    unsigned long generation; // Number of runs started
+    int running;              // Threads still working on the current run
+    bool shutdown;
+};
+
+/**
+ * @brief Start argument of worker threads 1..num_workers-1
+ */
+typedef struct {
+    worker_pool_t *pool;
+    int worker;
+} worker_start_t;
+
+/**
+ * @brief Run the pool's task once per run until the pool shuts down
+ */
+static void *worker_main(void *start_arg) {
+    worker_start_t start = *(worker_start_t *)start_arg;
+    free(start_arg);
+    worker_pool_t *pool = start.pool;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+        worker_task_fn task = pool->task;
+        void *arg = pool->arg;
+        pthread_mutex_unlock(&pool->lock);
+
+        task(arg, start.worker, pool->num_workers);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief Number of online CPUs (at least 1)
+ */
+static int online_cpus(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cpus > 0) ? (int)cpus : 1;
+}
+
+/**
+ * @brief Start a worker pool
+ * @param num_workers Number of workers including the calling thread (0 for one per online CPU)
+ * @return New pool, or NULL on an invalid count or if threads cannot be started
+ */
+worker_pool_t *create_worker_pool(int num_workers) {
+    if (num_workers == 0) {
+        num_workers = online_cpus();
+        num_workers = (num_workers < WORKER_POOL_MAX) ? num_workers : WORKER_POOL_MAX;
+    }
+    if (num_workers < 1 || num_workers > WORKER_POOL_MAX) {
+        return NULL;
+    }
+
+    worker_pool_t *pool = calloc(1, sizeof(worker_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->threads = calloc((size_t)num_workers, sizeof(pthread_t));
+    if (pool->threads == NULL) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    // Threads that did start are stopped again if a later one fails
+    pool->num_workers = 1;
+    for (int worker = 1; worker < num_workers; worker++) {
+        worker_start_t *start = malloc(sizeof(worker_start_t));
+        if (start == NULL) {
+            destroy_worker_pool(pool);
+            return NULL;
+        }
+        *start = (worker_start_t){pool, worker};
+        if (pthread_create(&pool->threads[worker], NULL, worker_main, start) != 0) {
+            free(start);
+            destroy_worker_pool(pool);
+            return NULL;
+        }
+        pool->num_workers++;
+    }
+    return pool;
+}
+
+/**
+ * @brief Stop and release a worker pool
+ * @param pool Pool to destroy (NULL is ignored)
+ *
+ * Must not be called while a run is in progress.
+ */
+void destroy_worker_pool(worker_pool_t *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int worker = 1; worker < pool->num_workers; worker++) {
+        pthread_join(pool->threads[worker], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    free(pool->threads);
+    free(pool);
+}
+
+/**
+ * @brief Number of workers of a pool, including the calling thread
+ * @param pool Worker pool (NULL counts as a single inline worker)
+ */
+int worker_pool_size(const worker_pool_t *pool) {
+    return (pool != NULL) ? pool->num_workers : 1;
+}
+
+/**
+ * @brief Run a task on every worker and wait for all of them
+ * @param pool Worker pool (NULL runs the task once, inline, as worker 0 of 1)
+ * @param task Task called as task(arg, worker, num_workers)
+ * @param arg Argument passed to every call
+ *
+ * Writes made by the workers are visible to the caller on return. Runs
+ * of one pool must not overlap.
+ */
+void worker_pool_run(worker_pool_t *pool, worker_task_fn task, void *arg) {
+    if (task == NULL) {
+        return;
+    }
+    if (pool == NULL || pool->num_workers == 1) {
+        task(arg, 0, 1);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->running = pool->num_workers - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    task(arg, 0, pool->num_workers);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->running > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
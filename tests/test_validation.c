@@ -9,14 +9,19 @@
  * - Task 4: Debugging (validation of fixes)
  * - Task 5: Error Handling
  * - Homework: Advanced patterns and error recovery
+ * - Monitor core: transports, register storage, fleets and scheduling
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 #include <math.h>
+#include <unistd.h>
 #include "../include/monitor.h"
+#include "register_map.h"
 
 // Test framework macros
 #define TEST_ASSERT(condition, message) \
@@ -37,6 +42,53 @@
 static int tests_run = 0;
 static int tests_passed = 0;
 
+// Scratch files of the running test, removed once it finishes
+#define TEST_PATH_LENGTH 64
+#define MAX_TEST_FILES 4
+static char test_files[MAX_TEST_FILES][TEST_PATH_LENGTH];
+static int test_file_count = 0;
+
+/**
+ * @brief Create a unique scratch file for the running test
+ * @param tag Part of the file name identifying the test
+ * @return Path of the new, empty file, or NULL if it could not be created
+ */
+static const char *create_test_file(const char *tag) {
+    if (test_file_count == MAX_TEST_FILES) {
+        return NULL;
+    }
+
+    char *path = test_files[test_file_count];
+    snprintf(path, TEST_PATH_LENGTH, "/tmp/day2_%s_XXXXXX", tag);
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return NULL;
+    }
+    close(fd);
+    test_file_count++;
+    return path;
+}
+
+/**
+ * @brief Undo process-wide state a test may have left behind
+ *
+ * A failed assertion returns from the middle of a test, so this also
+ * covers tests that never reached their own cleanup.
+ */
+static void restore_test_globals(void) {
+    stop_register_trace();
+    unload_register_trace();
+    detach_register_file();
+    set_register_transport(&simulated_transport);
+    set_report_sink(NULL);
+
+    for (int i = 0; i < test_file_count; i++) {
+        remove(test_files[i]);
+    }
+    test_file_count = 0;
+}
+
 /**
  * @brief Run a single test and update counters
  */
@@ -45,6 +97,7 @@ bool run_test(const char* test_name, bool (*test_func)(void)) {
     tests_run++;
 
     bool result = test_func();
+    restore_test_globals();
     if (result) {
         tests_passed++;
         printf("✓ %s PASSED\n", test_name);
@@ -150,6 +203,7 @@ bool test_check_critical_conditions(void) {
     system.error_count = MAX_ERRORS;
     TEST_ASSERT(check_critical_conditions(&system), "High error count should be critical");
 
+    cleanup_monitor_system(&system);
     TEST_PASS("Critical condition checking works correctly");
 }
 
@@ -170,6 +224,7 @@ bool test_scan_all_registers(void) {
     valid_count = scan_all_registers(NULL);
     TEST_ASSERT(valid_count == -1, "NULL pointer should return -1");
 
+    cleanup_monitor_system(&system);
     TEST_PASS("Register scanning works correctly");
 }
 
@@ -187,6 +242,7 @@ bool test_continuous_monitoring_loop(void) {
     continuous_monitoring_loop(&system, 0);
     continuous_monitoring_loop(&system, -1);
 
+    cleanup_monitor_system(&system);
     TEST_PASS("Continuous monitoring loop works correctly");
 }
 
@@ -205,10 +261,11 @@ bool test_count_valid_registers(void) {
 
     // Test with invalid registers - store original count first
     int original_count = count;
-    system.registers[0].is_valid = false;
+    set_register_valid(&system, 0, false);
     int new_count = count_valid_registers(&system);
     TEST_ASSERT(new_count == original_count - 1, "Invalid register should reduce count");
 
+    cleanup_monitor_system(&system);
     TEST_PASS("Register counting works correctly");
 }
 
@@ -219,7 +276,7 @@ bool test_update_all_registers(void) {
     // Store original values
     uint32_t original_values[MAX_REGISTERS];
     for (int i = 0; i < system.num_registers; i++) {
-        original_values[i] = system.registers[i].value;
+        original_values[i] = register_value(&system, i);
     }
 
     // Update registers
@@ -231,9 +288,1263 @@ bool test_update_all_registers(void) {
     // Test NULL pointer (should handle gracefully)
     update_all_registers(NULL);
 
+    cleanup_monitor_system(&system);
     TEST_PASS("Register update works correctly");
 }
 
+/**
+ * Monitor Core Tests: Register Access and Transports
+ */
+
+bool test_read_registers_bulk(void) {
+    monitor_system_t system;
+    init_monitor_system(&system);
+
+    // Bulk read must produce the same value range as single reads
+    uint32_t addrs[4] = {0x40000000, 0x40000004, 0x40000008, 0x4000000C};
+    uint32_t bulk[4];
+
+    TEST_ASSERT(read_registers_bulk(addrs, bulk, 4) == 4, "Bulk read should read all registers");
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT(bulk[i] >= 0x12345678 && bulk[i] <= 0x12345678 + 0xF0,
+                    "Bulk values should match the simulated register pattern");
+    }
+
+    // Test NULL pointers
+    TEST_ASSERT(read_registers_bulk(NULL, bulk, 4) == 0, "NULL addresses should read nothing");
+    TEST_ASSERT(read_system_registers_bulk(NULL) == -1, "NULL system should return -1");
+
+    TEST_ASSERT(read_system_registers_bulk(&system) == system.num_registers,
+                "System bulk read should cover every register");
+
+    cleanup_monitor_system(&system);
+    TEST_PASS("Bulk register read works correctly");
+}
+
+bool test_register_file_backend(void) {
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    TEST_PASS("Register file backend skipped (simulated transport pinned at compile time)");
+#endif
+    const char *path = create_test_file("register_file");
+    TEST_ASSERT(path != NULL, "Scratch register file should be created");
+
+    TEST_ASSERT(attach_register_file(path, 0), "Register file should attach");
+    TEST_ASSERT(register_file_attached(), "Register file should report attached");
+    set_register_transport(&file_transport);
+
+    // Writes land in the file and read back as plain loads
+    TEST_ASSERT(write_register(0x40000008, 0x15000000), "Write to mapped register should succeed");
+    TEST_ASSERT(read_register(0x40000008) == 0x15000000, "Read should return the stored value");
+
+    uint32_t addrs[2] = {0x40000008, 0x4000000C};
+    uint32_t values[2];
+    write_register(0x4000000C, 0x16000000);
+    read_registers_bulk(addrs, values, 2);
+    TEST_ASSERT(values[0] == 0x15000000 && values[1] == 0x16000000,
+                "Bulk read should load from the mapped file");
+
+    // Unaligned addresses fall back to simulation
+    uint32_t unused;
+    TEST_ASSERT(!register_file_read(0x40000002, &unused), "Unaligned address should not map");
+
+    // A fleet grows the window so its upper chips read the file too
+    chip_fleet_t *fleet = create_chip_fleet(20);
+    size_t fleet_window = register_file_size();
+    uint32_t last_chip_address = register_address(&fleet->chips[19].monitor, 0);
+    bool last_chip_mapped = register_file_write(last_chip_address, 0x17000000) &&
+                            read_register(last_chip_address) == 0x17000000;
+    destroy_chip_fleet(fleet);
+
+    // Attaching never shrinks the file, and a default attach maps all of it
+    attach_register_file(path, 0x1000);
+    attach_register_file(path, 0);
+    size_t reattached_window = register_file_size();
+    uint32_t preserved = read_register(last_chip_address);
+
+    detach_register_file();
+    set_register_transport(&simulated_transport);
+    remove(path);
+    TEST_ASSERT(!register_file_attached(), "Register file should detach");
+    TEST_ASSERT(fleet_window > REGISTER_FILE_DEFAULT_SIZE, "Window should grow to cover the fleet");
+    TEST_ASSERT(last_chip_mapped, "Upper chips of a file-backed fleet should read the file");
+    TEST_ASSERT(reattached_window == fleet_window && preserved == 0x17000000,
+                "A smaller attach should not truncate the register file");
+
+    TEST_PASS("Register file backend works correctly");
+}
+
+bool test_shadow_register_cache(void) {
+    monitor_system_t system;
+    init_monitor_system(&system);
+
+    // Repeated writes coalesce into one pending write per register
+    TEST_ASSERT(shadow_write_register(&system, 0, 0x11111111), "Shadow write should succeed");
+    TEST_ASSERT(shadow_write_register(&system, 0, 0x12222222), "Repeated shadow write should succeed");
+    TEST_ASSERT(shadow_write_register(&system, 2, 0x13333333), "Shadow write should succeed");
+    TEST_ASSERT(shadow_read_register(&system, 0) == 0x12222222, "Pending write should be readable");
+    TEST_ASSERT(flush_shadow_registers(&system) == 2, "Flush should push two dirty registers");
+    TEST_ASSERT(flush_shadow_registers(&system) == 0, "Second flush should have nothing to push");
+
+    // CTRL_REG is cached, DATA_REG is not
+    TEST_ASSERT(shadow_read_register(&system, 0) == 0x12222222, "Cached register should read from shadow");
+    TEST_ASSERT(shadow_read_register(&system, 2) != 0x13333333, "Uncached register should read hardware");
+
+    // A scan sees a staged write to DATA_REG until it is flushed, like shadow reads do
+    TEST_ASSERT(shadow_write_register(&system, 2, 0x13333333), "Shadow write should succeed");
+    read_system_registers_bulk(&system);
+    TEST_ASSERT(register_value(&system, 2) == 0x13333333, "Scan should see the pending DATA_REG write");
+    flush_shadow_registers(&system);
+    read_system_registers_bulk(&system);
+    TEST_ASSERT(register_value(&system, 2) != 0x13333333, "Scan should read DATA_REG after the flush");
+
+    // Invalid arguments
+    TEST_ASSERT(!shadow_write_register(&system, MAX_REGISTERS, 0), "Out-of-range index should fail");
+    TEST_ASSERT(!shadow_write_register(NULL, 0, 0), "NULL system should fail");
+    TEST_ASSERT(flush_shadow_registers(NULL) == -1, "NULL system flush should return -1");
+
+    cleanup_monitor_system(&system);
+    TEST_PASS("Shadow register cache works correctly");
+}
+
+bool test_register_transport_selection(void) {
+    TEST_ASSERT(find_register_transport("sim") == &simulated_transport, "sim backend should exist");
+    TEST_ASSERT(find_register_transport("file") == &file_transport, "file backend should exist");
+    TEST_ASSERT(find_register_transport("replay") == &replay_transport, "replay backend should exist");
+    TEST_ASSERT(find_register_transport("bogus") == NULL, "Unknown backend should not exist");
+
+    // Systems pick up the transport that is current at init time
+    monitor_system_t system;
+    set_register_transport(&replay_transport);
+    init_monitor_system(&system);
+    set_register_transport(&simulated_transport);
+    TEST_ASSERT(system.transport == &replay_transport, "System should keep its init-time transport");
+    cleanup_monitor_system(&system);
+
+    init_monitor_system(&system);
+    TEST_ASSERT(system.transport == &simulated_transport, "System should use the default transport");
+    cleanup_monitor_system(&system);
+
+    TEST_PASS("Register transport selection works correctly");
+}
+
+bool test_register_trace_replay(void) {
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    TEST_PASS("Register trace replay skipped (simulated transport pinned at compile time)");
+#endif
+    const char *path = create_test_file("register_trace");
+    uint32_t addrs[3] = {0x40000000, 0x40000004, 0x40000008};
+    uint32_t recorded[4];
+    uint32_t replayed[4];
+    TEST_ASSERT(path != NULL, "Scratch trace file should be created");
+
+    // Record a bulk read, a write and a single read
+    TEST_ASSERT(start_register_trace(path), "Trace recording should start");
+    read_registers_bulk(addrs, recorded, 3);
+    write_register(0x4000000C, 0x15000000);
+    recorded[3] = read_register(0x4000000C);
+    TEST_ASSERT(stop_register_trace() == 5, "Trace should hold five records");
+    TEST_ASSERT(stop_register_trace() == -1, "Stopping twice should fail");
+
+    // A trace whose writes fail is not reported as complete
+    if (start_register_trace("/dev/full")) {
+        uint32_t discarded[3];
+        read_registers_bulk(addrs, discarded, 3);
+        TEST_ASSERT(stop_register_trace() == -1, "A trace that could not be written should fail to stop");
+        TEST_ASSERT(get_register_transport() == &simulated_transport,
+                    "A failed trace should still restore the transport");
+    }
+
+    // Replay feeds back the recorded reads in order
+    TEST_ASSERT(load_register_trace(path), "Trace should load");
+    set_register_transport(&replay_transport);
+    read_registers_bulk(addrs, replayed, 3);
+    replayed[3] = read_register(0x4000000C);
+
+    // Values follow the address, whatever order the replay reads in
+    uint32_t reordered[2];
+    reordered[0] = read_register(0x40000008);
+    reordered[1] = read_register(0x40000000);
+    uint32_t unrecorded = read_register(0x40000100);
+    size_t misses = register_replay_misses();
+    set_register_transport(&simulated_transport);
+    unload_register_trace();
+    remove(path);
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT(replayed[i] == recorded[i], "Replayed value should match recording");
+    }
+    TEST_ASSERT(reordered[0] == recorded[2] && reordered[1] == recorded[0],
+                "Reordered replay should return each register's recorded value");
+    TEST_ASSERT(unrecorded == 0 && misses == 1, "Reads the trace never made should be reported");
+
+    TEST_ASSERT(!load_register_trace("/nonexistent/trace.bin"), "Missing trace should not load");
+
+    // A record count that would wrap the allocation size is rejected against the file size
+    register_trace_header_t crafted = {{'R', 'T', 'R', 'C'}, REGISTER_TRACE_VERSION,
+                                       UINT64_MAX / sizeof(register_trace_record_t) + 2};
+    register_trace_record_t crafted_records[4];
+    memset(crafted_records, 0, sizeof(crafted_records));
+    FILE *file = fopen(path, "wb");
+    TEST_ASSERT(file != NULL, "Crafted trace should be created");
+    fwrite(&crafted, sizeof(crafted), 1, file);
+    fwrite(crafted_records, sizeof(crafted_records[0]), 4, file);
+    fclose(file);
+    bool loaded = load_register_trace(path);
+    remove(path);
+    TEST_ASSERT(!loaded, "Trace claiming more records than it holds should not load");
+
+    // Systems initialized while recording keep working once the recording stops
+    TEST_ASSERT(start_register_trace(path), "Trace recording should restart");
+    monitor_system_t recorded_system;
+    init_monitor_system(&recorded_system);
+    long records = stop_register_trace();
+    for (int i = 0; i < 3000; i++) {
+        read_system_registers_bulk(&recorded_system);
+    }
+    cleanup_monitor_system(&recorded_system);
+    remove(path);
+    TEST_ASSERT(records >= 0, "Trace with no accesses should stop cleanly");
+
+    TEST_PASS("Register trace record and replay work correctly");
+}
+
+bool test_seeded_simulated_registers(void) {
+    monitor_system_t first;
+    monitor_system_t second;
+    init_monitor_system(&first);
+    init_monitor_system(&second);
+    seed_monitor_system(&first, 7);
+    seed_monitor_system(&second, 7);
+
+    // Unrelated reads on this thread must not disturb a system's values
+    read_system_registers_bulk(&first);
+    read_register(0x40000000);
+    read_register(0x40000004);
+    read_system_registers_bulk(&second);
+
+    for (int i = 0; i < first.num_registers; i++) {
+        TEST_ASSERT(register_value(&first, i) == register_value(&second, i),
+                    "Equally seeded systems should read identical values");
+    }
+    TEST_ASSERT(first.sim_sequence == second.sim_sequence,
+                "Equally seeded systems should advance identically");
+
+    cleanup_monitor_system(&first);
+    cleanup_monitor_system(&second);
+    TEST_PASS("Seeded simulated registers are reproducible");
+}
+
+bool test_report_sinks(void) {
+    const char *text_path = create_test_file("report_sink_text");
+    const char *binary_path = create_test_file("report_sink_binary");
+    TEST_ASSERT(text_path != NULL && binary_path != NULL, "Scratch sink files should be created");
+
+    // Null sink: validators still return results
+    set_report_sink(&null_sink);
+    bool voltage_ok = validate_voltage_range(3.3f);
+    bool temp_ok = validate_temperature_range(TEMP_CRITICAL + 1.0f);
+    set_report_sink(NULL);
+    TEST_ASSERT(voltage_ok, "Validator should work with the null sink");
+    TEST_ASSERT(!temp_ok, "Validator result should not depend on sink");
+
+    // Buffered file sink: same text as the console
+    report_sink_t file_sink;
+    TEST_ASSERT(open_file_sink(&file_sink, text_path), "File sink should open");
+    set_report_sink(&file_sink);
+    validate_voltage_range(3.3f);
+    close_report_sink(&file_sink);
+    TEST_ASSERT(get_report_sink() == &console_sink, "Closing the active sink should restore the console");
+
+    char line[128] = "";
+    FILE *text = fopen(text_path, "r");
+    TEST_ASSERT(text != NULL && fgets(line, sizeof(line), text) != NULL, "File sink should write text");
+    fclose(text);
+    remove(text_path);
+    TEST_ASSERT(strcmp(line, "PASS: Voltage within range: 3.30V\n") == 0, "File sink text should match console");
+
+    // Binary sink: one fixed-size record per event
+    report_sink_t binary_sink;
+    TEST_ASSERT(open_binary_sink(&binary_sink, binary_path), "Binary sink should open");
+    set_report_sink(&binary_sink);
+    validate_voltage_range(2.5f);
+    validate_temperature_range(80.0f);
+    close_report_sink(&binary_sink);
+
+    report_record_t records[2];
+    FILE *binary = fopen(binary_path, "rb");
+    TEST_ASSERT(binary != NULL, "Binary sink should create its file");
+    size_t count = fread(records, sizeof(records[0]), 2, binary);
+    fclose(binary);
+    remove(binary_path);
+    TEST_ASSERT(count == 2, "Binary sink should write two records");
+    TEST_ASSERT(records[0].type == REPORT_VOLTAGE_CHECK && records[0].outcome == REPORT_FAIL,
+                "First record should be a failed voltage check");
+    TEST_ASSERT(records[1].type == REPORT_TEMPERATURE_CHECK && records[1].outcome == REPORT_WARN,
+                "Second record should be a temperature warning");
+
+    TEST_PASS("Reporting sinks work correctly");
+}
+
+bool test_register_poller(void) {
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    TEST_PASS("Register poller skipped (simulated transport pinned at compile time)");
+#endif
+    const char *path = create_test_file("register_poll");
+    TEST_ASSERT(path != NULL, "Scratch register file should be created");
+
+    TEST_ASSERT(open_register_poller(4) == NULL, "Poller needs an attached register file");
+    TEST_ASSERT(attach_register_file(path, 0), "Register file should attach");
+    set_register_transport(&file_transport);
+
+    // Register 0 is out of range, the others sit on their lower bound
+    monitor_system_t system;
+    init_monitor_system(&system);
+    uint32_t expected[MAX_REGISTERS];
+    for (int i = 0; i < system.num_registers; i++) {
+        expected[i] = (i == 0) ? system.regs.max[0] + 1 : system.regs.min[i];
+        write_register(register_address(&system, i), expected[i]);
+    }
+
+    register_poller_t *poller = open_register_poller(4);
+    TEST_ASSERT(poller != NULL, "Poller should open on the register file");
+    TEST_ASSERT(register_poller_submit(poller, &system), "Block read should be queued");
+    register_poller_kick(poller);
+    register_poller_reap(poller, true);
+
+    bool loaded = true;
+    for (int i = 0; i < system.num_registers; i++) {
+        loaded = loaded && register_value(&system, i) == expected[i] &&
+                 register_is_valid(&system, i) == (i != 0);
+    }
+
+    // Registers past the end of the attached window are rejected up front
+    monitor_system_t outside;
+    init_monitor_system(&outside);
+    for (int i = 0; i < outside.num_registers; i++) {
+        outside.regs.addresses[i] = REGISTER_FILE_BASE + REGISTER_FILE_DEFAULT_SIZE + 4u * (uint32_t)i;
+    }
+    bool rejected = !register_poller_submit(poller, &outside);
+    cleanup_monitor_system(&outside);
+
+    // Emptying the file makes every read short; the registers must not keep stale values as valid
+    FILE *file = fopen(path, "w");
+    if (file != NULL) {
+        fclose(file);
+    }
+    register_poller_submit(poller, &system);
+    register_poller_reap(poller, true);
+    bool invalidated = true;
+    for (int i = 0; i < system.num_registers; i++) {
+        invalidated = invalidated && !register_is_valid(&system, i);
+    }
+
+    close_register_poller(poller);
+    detach_register_file();
+    set_register_transport(&simulated_transport);
+    cleanup_monitor_system(&system);
+    remove(path);
+
+    TEST_ASSERT(loaded, "Polled values should match the register file and be validated");
+    TEST_ASSERT(rejected, "Registers outside the register window should be rejected");
+    TEST_ASSERT(invalidated, "A short block read should mark the registers invalid");
+    TEST_PASS("Register poller works correctly");
+}
+
+/**
+ * Transport that corrupts the first few bulk transfers, differently each time
+ */
+static int corrupt_transfers_left = 0;
+
+static size_t corrupting_read_bulk(const uint32_t *addrs, uint32_t *out, size_t n) {
+    size_t done = simulated_transport.read_bulk(addrs, out, n);
+    if (corrupt_transfers_left > 0 && done > 0) {
+        out[done - 1] ^= (uint32_t)corrupt_transfers_left << 16;
+        corrupt_transfers_left--;
+    }
+    return done;
+}
+
+static const register_transport_t corrupting_transport = {
+    "corrupt", NULL, NULL, corrupting_read_bulk, NULL
+};
+
+bool test_checked_register_reads(void) {
+#ifdef REGISTER_TRANSPORT_FIXED_SIM
+    TEST_PASS("Fault injection skipped (simulated transport pinned at compile time)");
+#endif
+
+    monitor_system_t system;
+    init_monitor_system(&system);
+    system.transport = &corrupting_transport;
+
+    // One corrupted transfer is retried
+    corrupt_transfers_left = 1;
+    TEST_ASSERT(read_system_registers_checked(&system, 2) == ERROR_NONE,
+                "Corrupted block should be retried");
+    for (int i = 0; i < system.num_registers; i++) {
+        TEST_ASSERT(register_value(&system, i) >= 0x12345678 &&
+                    register_value(&system, i) <= 0x12345678 + 0xF0,
+                    "Accepted values should be uncorrupted");
+    }
+
+    // Persistent corruption is reported and leaves the registers alone
+    uint32_t before = register_value(&system, 1);
+    corrupt_transfers_left = 100;
+    TEST_ASSERT(read_system_registers_checked(&system, 2) == ERROR_INVALID_DATA,
+                "Persistent corruption should produce ERROR_INVALID_DATA");
+    TEST_ASSERT(register_value(&system, 1) == before, "Rejected block should not be stored");
+    corrupt_transfers_left = 0;
+
+    TEST_ASSERT(read_system_registers_checked(NULL, 2) == ERROR_INVALID_DATA,
+                "NULL system should fail");
+
+    // A recorded checked read is traced once and replays as accepted
+    const char *path = create_test_file("checked_trace");
+    TEST_ASSERT(path != NULL && start_register_trace(path), "Trace recording should start");
+    monitor_system_t traced;
+    init_monitor_system(&traced);
+    error_code_t recorded_result = read_system_registers_checked(&traced, 2);
+    long records = stop_register_trace();
+    uint32_t recorded_value = register_value(&traced, 1);
+
+    TEST_ASSERT(load_register_trace(path), "Checked-read trace should load");
+    traced.transport = &replay_transport;
+    error_code_t replayed_result = read_system_registers_checked(&traced, 2);
+    uint32_t replayed_value = register_value(&traced, 1);
+    unload_register_trace();
+    remove(path);
+    int traced_registers = traced.num_registers;
+    cleanup_monitor_system(&traced);
+    cleanup_monitor_system(&system);
+
+    TEST_ASSERT(recorded_result == ERROR_NONE, "Checked read should pass while recording");
+    TEST_ASSERT(records == traced_registers, "Checked read should trace each register once");
+    TEST_ASSERT(replayed_result == ERROR_NONE && replayed_value == recorded_value,
+                "Replayed checked read should return the recorded block");
+
+    TEST_PASS("Checked register reads work correctly");
+}
+
+/**
+ * Monitor Core Tests: Validation and Register Storage
+ */
+
+bool test_validate_registers_batch(void) {
+    enum { COUNT = 100 };
+    uint32_t values[COUNT], min[COUNT], max[COUNT];
+    uint64_t bitmap[(COUNT + 63) / 64];
+
+    // Bounds straddle the sign bit so unsigned comparison is exercised
+    uint32_t seed = 12345;
+    for (int i = 0; i < COUNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        values[i] = seed;
+        min[i] = 0x40000000u;
+        max[i] = 0xC0000000u;
+    }
+    values[0] = 0x40000000u;  // Inclusive bounds
+    values[1] = 0xC0000000u;
+    values[2] = 0xFFFFFFFFu;
+    values[3] = 0;
+
+    size_t expected_valid = 0;
+    for (int i = 0; i < COUNT; i++) {
+        expected_valid += (values[i] >= min[i] && values[i] <= max[i]);
+    }
+
+    size_t valid = validate_registers_batch(values, min, max, COUNT, bitmap);
+    TEST_ASSERT(valid == expected_valid, "Batch should count every in-range value");
+    for (int i = 0; i < COUNT; i++) {
+        bool bit = (bitmap[i / 64] >> (i % 64)) & 1;
+        TEST_ASSERT(bit == (values[i] >= min[i] && values[i] <= max[i]),
+                    "Bitmap should match the scalar range check");
+    }
+    TEST_ASSERT(validate_registers_batch(NULL, min, max, COUNT, bitmap) == 0,
+                "NULL values should fail");
+
+    monitor_system_t system;
+    init_monitor_system(&system);
+    set_register_value(&system, 0, register_min(&system, 0));
+    set_register_value(&system, 1, register_max(&system, 1) + 1);
+    int system_valid = validate_system_registers(&system);
+    TEST_ASSERT(register_is_valid(&system, 0) && !register_is_valid(&system, 1),
+                "System registers should be flagged from their bounds");
+    TEST_ASSERT(system_valid >= 1 && system_valid <= system.num_registers - 1,
+                "System valid count should reflect the flags");
+
+    cleanup_monitor_system(&system);
+    TEST_PASS("Batch register validation works correctly");
+}
+
+bool test_system_status_batch(void) {
+    enum { COUNT = 37 };
+    const float voltages[] = {2.9f, MIN_VOLTAGE, NOMINAL_VOLTAGE, MAX_VOLTAGE, 3.7f, NAN};
+    const float temperatures[] = {-40.0f, TEMP_NORMAL, TEMP_WARNING, 80.0f, TEMP_CRITICAL, 90.0f, NAN};
+    const float currents[] = {0.0f, MIN_CURRENT, NOMINAL_CURRENT, MAX_CURRENT, 2.5f, NAN};
+    float voltage[COUNT], temperature[COUNT], current[COUNT];
+    system_status_t status[COUNT];
+
+    // Walk the boundary values with co-prime strides so the lanes mix
+    for (int i = 0; i < COUNT; i++) {
+        voltage[i] = voltages[i % 6];
+        temperature[i] = temperatures[(i * 3) % 7];
+        current[i] = currents[(i * 5) % 6];
+    }
+
+    size_t critical = determine_system_status_batch(voltage, temperature, current, COUNT, status);
+
+    // Compare against the scalar classifier with its reports discarded
+    size_t expected_critical = 0;
+    bool matches = true;
+    set_report_sink(&null_sink);
+    for (int i = 0; i < COUNT; i++) {
+        system_status_t expected = determine_system_status(voltage[i], temperature[i], current[i]);
+        matches = matches && status[i] == expected;
+        expected_critical += (expected == STATUS_CRITICAL);
+    }
+    set_report_sink(NULL);
+
+    TEST_ASSERT(matches, "Batch statuses should match determine_system_status()");
+    TEST_ASSERT(critical == expected_critical, "Batch should count critical chips");
+    TEST_ASSERT(determine_system_status_batch(NULL, temperature, current, COUNT, status) == 0,
+                "NULL readings should fail");
+
+    TEST_PASS("Batch status classification works correctly");
+}
+
+bool test_classify_system_status(void) {
+    const float voltages[] = {2.9f, MIN_VOLTAGE, NOMINAL_VOLTAGE, MAX_VOLTAGE, 3.7f, NAN};
+    const float temperatures[] = {-40.0f, TEMP_NORMAL, TEMP_WARNING, 80.0f, TEMP_CRITICAL, 90.0f, NAN};
+    const float currents[] = {0.0f, MIN_CURRENT, NOMINAL_CURRENT, MAX_CURRENT, 2.5f, NAN};
+    bool matches = true;
+
+    // Every combination of boundary readings, reports discarded
+    set_report_sink(&null_sink);
+    for (int v = 0; v < 6; v++) {
+        for (int t = 0; t < 7; t++) {
+            for (int c = 0; c < 6; c++) {
+                matches = matches &&
+                    classify_system_status(voltages[v], temperatures[t], currents[c]) ==
+                    determine_system_status(voltages[v], temperatures[t], currents[c]);
+            }
+        }
+    }
+    set_report_sink(NULL);
+
+    TEST_ASSERT(matches, "Lookup-table classifier should match determine_system_status()");
+    TEST_PASS("Lookup-table status classifier works correctly");
+}
+
+bool test_generated_register_map(void) {
+    monitor_system_t system;
+    init_monitor_system(&system);
+
+    TEST_ASSERT(load_register_map(&system) == REGISTER_MAP_COUNT, "Whole register map should load");
+    TEST_ASSERT(strcmp(register_name(&system, REGMAP_ERROR_MASK), "ERROR_MASK") == 0,
+                "Names should come from the register map");
+    TEST_ASSERT(register_address(&system, REGMAP_TEMP_REG) == 0x40000024 &&
+                register_max(&system, REGMAP_TEMP_REG) == 0x16000000,
+                "Addresses and bounds should come from the register map");
+    TEST_ASSERT(system.shadow_cached[0] == ((1ull << REGMAP_CTRL_REG) | (1ull << REGMAP_CONFIG_REG) |
+                                            (1ull << REGMAP_MODE_REG)),
+                "Control registers should be cacheable");
+
+    // The unrolled check agrees with the batch validator plus the compiled fields
+    TEST_ASSERT(system.field_checks != NULL && system.field_checks->count == REGISTER_MAP_FIELD_COUNT,
+                "Register map fields should be compiled");
+    uint32_t values[REGISTER_MAP_COUNT];
+    uint32_t seed = 99;
+    for (int round = 0; round < 8; round++) {
+        for (int i = 0; i < REGISTER_MAP_COUNT; i++) {
+            seed = seed * 1103515245u + 12345u;
+            values[i] = (round == 0) ? register_map_min[i] :
+                        (round == 1) ? register_map_max[i] : seed >> (round % 5);
+        }
+
+        uint64_t bitmap[1];
+        validate_registers_batch(values, register_map_min, register_map_max,
+                                 REGISTER_MAP_COUNT, bitmap);
+        validate_register_fields(system.field_checks, values, bitmap);
+        TEST_ASSERT(validate_register_map(values) == (uint32_t)bitmap[0],
+                    "Unrolled validation should match the batch validator");
+    }
+    TEST_ASSERT(validate_register_map(NULL) == 0, "NULL values should fail");
+
+    cleanup_monitor_system(&system);
+    TEST_PASS("Generated register map works correctly");
+}
+
+bool test_register_store(void) {
+    monitor_system_t system;
+    init_monitor_system(&system);
+
+    // Hot fields are contiguous arrays, validity is a bitmap
+    TEST_ASSERT(&system.regs.values[1] == &system.regs.values[0] + 1, "Values should be contiguous");
+    TEST_ASSERT(system.regs.valid[0] == (1ull << system.num_registers) - 1,
+                "Every register should start valid");
+
+    // The per-register view round-trips through the store
+    register_info_t info;
+    TEST_ASSERT(get_register_info(&system, 2, &info), "Register info should be readable");
+    TEST_ASSERT(info.address == register_address(&system, 2) && info.is_valid,
+                "Register info should reflect the store");
+
+    info.value = 0x1ABCDEF0;
+    info.expected_min = 0x1A000000;
+    info.is_valid = false;
+    strcpy(info.name, "RENAMED_REG");
+    TEST_ASSERT(set_register_info(&system, 2, &info), "Register info should be writable");
+    TEST_ASSERT(register_value(&system, 2) == 0x1ABCDEF0 && register_min(&system, 2) == 0x1A000000,
+                "Stored fields should be readable through the accessors");
+    TEST_ASSERT(!register_is_valid(&system, 2) && register_is_valid(&system, 1),
+                "Only the stored register's validity bit should change");
+    TEST_ASSERT(strcmp(register_name(&system, 2), "RENAMED_REG") == 0, "Name should be stored");
+
+    TEST_ASSERT(!get_register_info(&system, system.num_registers, &info),
+                "Out-of-range index should fail");
+    TEST_ASSERT(!set_register_info(NULL, 0, &info), "NULL system should fail");
+
+    cleanup_monitor_system(&system);
+    TEST_PASS("Register store works correctly");
+}
+
+bool test_sized_register_sets(void) {
+    register_arena_t arena;
+    register_arena_init(&arena, 0);
+    monitor_system_t system;
+    init_monitor_system_in(&system, &arena);
+
+    // A large register set spans many bitmap words
+    TEST_ASSERT(allocate_register_set(&system, &arena, 4096), "4096 registers should fit");
+    TEST_ASSERT(system.num_registers == 4096 && system.regs.capacity == 4096,
+                "Store should be sized for the requested registers");
+    TEST_ASSERT(((uintptr_t)system.regs.values % REGISTER_ARENA_ALIGN) == 0,
+                "Arrays should be cache-line aligned");
+    for (int i = 0; i < system.num_registers; i++) {
+        define_register(&system, i, REGISTER_FILE_BASE + 4u * (uint32_t)i,
+                        0x12345678, 0x12345678 + 0x80, "BULK_REG");
+    }
+    TEST_ASSERT(!register_is_valid(&system, 0) && !register_is_valid(&system, 4095),
+                "New registers should start invalid");
+
+    TEST_ASSERT(read_system_registers_bulk(&system) == 4096, "Every register should be read");
+    int valid = validate_system_registers(&system);
+    int expected = 0;
+    for (int i = 0; i < system.num_registers; i++) {
+        expected += (register_value(&system, i) <= 0x12345678 + 0x80);
+    }
+    TEST_ASSERT(valid == expected && valid > 0 && valid < 4096,
+                "Validation should cover every register");
+
+    // Shadow cache works past the first bitmap word
+    TEST_ASSERT(shadow_write_register(&system, 4000, 0x12345600), "High shadow write should succeed");
+    TEST_ASSERT(shadow_read_register(&system, 4000) == 0x12345600, "High shadow read should hit");
+    TEST_ASSERT(flush_shadow_registers(&system) == 1, "Flush should push the high register");
+    TEST_ASSERT(!allocate_register_set(&system, &arena, MAX_REGISTERS + 1),
+                "Oversized register set should fail");
+    TEST_ASSERT(!allocate_register_set(&system, &arena, 0), "Empty register set should fail");
+
+    // A small set only pays for its own registers
+    size_t before = arena.used;
+    TEST_ASSERT(allocate_register_set(&system, &arena, 4), "Small register set should fit");
+    TEST_ASSERT(arena.used - before < 4096, "Small register set should stay small");
+    TEST_ASSERT(load_register_map(&system) == REGISTER_MAP_COUNT, "Register map should resize the store");
+
+    cleanup_monitor_system(&system);
+    register_arena_reset(&arena);
+    TEST_ASSERT(arena.used == 0 && arena.blocks == NULL, "Reset should release the arena");
+
+    // Systems without an arena own their store; cleanup releases it, so
+    // re-initializing takes nothing from a shared arena (the register
+    // map's bitfield rules are compiled into the default arena once)
+    monitor_system_t owned;
+    init_monitor_system(&owned);
+    load_register_map(&owned);
+    cleanup_monitor_system(&owned);
+    size_t shared_before = default_register_arena()->used;
+    for (int round = 0; round < 50; round++) {
+        init_monitor_system(&owned);
+        TEST_ASSERT(owned.arena == NULL && owned.owned_store != NULL, "System should own its store");
+        TEST_ASSERT(load_register_map(&owned) == REGISTER_MAP_COUNT &&
+                    find_register_by_name(&owned, "CTRL_REG") >= 0,
+                    "Owned store should be resized to the register map");
+        cleanup_monitor_system(&owned);
+        TEST_ASSERT(owned.owned_store == NULL && owned.num_registers == 0,
+                    "Cleanup should release the register store");
+    }
+    TEST_ASSERT(default_register_arena()->used == shared_before,
+                "Re-initialized systems should not grow the shared arena");
+
+    TEST_PASS("Sized register sets work correctly");
+}
+
+bool test_interned_register_names(void) {
+    monitor_system_t first, second;
+    init_monitor_system(&first);
+    init_monitor_system(&second);
+
+    // Equal names share one symbol and one copy of the text
+    TEST_ASSERT(first.name_ids[1] == second.name_ids[1], "Equal names should share a symbol");
+    TEST_ASSERT(register_name(&first, 1) == register_name(&second, 1), "Equal names should share text");
+    TEST_ASSERT(intern_register_name("STATUS_REG") == first.name_ids[1], "Interning should be idempotent");
+    TEST_ASSERT(find_register_symbol("NEVER_INTERNED_REG") == REGISTER_SYMBOL_NONE,
+                "Unknown names should have no symbol");
+    TEST_ASSERT(strcmp(register_symbol_name(REGISTER_SYMBOL_EMPTY), "") == 0, "Symbol 0 should be empty");
+
+    // Perfect-hash name lookup, rebuilt after renames
+    TEST_ASSERT(find_register_by_name(&first, "DATA_REG") == 2, "Lookup should find DATA_REG");
+    TEST_ASSERT(find_register_by_name(&first, "BOGUS_REG") == -1, "Unknown name should not be found");
+    set_register_name(&first, 2, "RENAMED_DATA_REG");
+    TEST_ASSERT(find_register_by_name(&first, "RENAMED_DATA_REG") == 2, "Lookup should see renames");
+    TEST_ASSERT(find_register_by_name(&first, "DATA_REG") == -1, "Old name should be gone");
+    TEST_ASSERT(find_register_by_name(&second, "DATA_REG") == 2, "Other systems should be unaffected");
+
+    // Rebuilding the index replaces the previous tables instead of piling them up
+    size_t index_bytes = first.name_index_arena.used;
+    for (int round = 0; round < 100; round++) {
+        set_register_name(&first, 2, (round % 2 == 0) ? "DATA_REG" : "RENAMED_DATA_REG");
+        find_register_by_name(&first, "DATA_REG");
+    }
+    TEST_ASSERT(first.name_index_arena.used == index_bytes, "Renames should not grow the name index");
+
+    // Chip names resolve before anyone has formatted them
+    second.name_chip = 4242;
+    TEST_ASSERT(find_register_symbol("CHIP4242_CONFIG_REG") == REGISTER_SYMBOL_NONE,
+                "Chip name should not be interned yet");
+    TEST_ASSERT(find_register_by_name(&second, "CHIP4242_CONFIG_REG") == 3,
+                "Unformatted chip name lookup should work");
+    TEST_ASSERT(find_register_by_name(&second, "CHIP424_CONFIG_REG") == -1 &&
+                find_register_by_name(&second, "CHIP4242_") == -1, "Malformed chip names should not match");
+
+    // Chip names are derived on demand and resolve back to the register
+    second.name_chip = 7;
+    TEST_ASSERT(strcmp(register_name(&second, 3), "CHIP7_CONFIG_REG") == 0, "Chip name should be derived");
+    TEST_ASSERT(register_name(&second, 3) == register_name(&second, 3), "Chip names should be cached");
+    TEST_ASSERT(find_register_by_name(&second, "CHIP7_CONFIG_REG") == 3, "Chip name lookup should work");
+    TEST_ASSERT(find_register_by_name(&second, "CHIP6_CONFIG_REG") == -1,
+                "Another chip's name should not match");
+
+    // Chip names that would be truncated keep their base name instead of colliding
+    second.name_chip = 262143;
+    set_register_name(&second, 0, "LONG_REGISTER_NAME_ABCDEF_ONE");
+    set_register_name(&second, 1, "LONG_REGISTER_NAME_ABCDEF_TWO");
+    TEST_ASSERT(strcmp(register_name(&second, 0), "LONG_REGISTER_NAME_ABCDEF_ONE") == 0 &&
+                strcmp(register_name(&second, 1), "LONG_REGISTER_NAME_ABCDEF_TWO") == 0,
+                "Truncated chip names should fall back to the base name");
+    TEST_ASSERT(find_register_by_name(&second, "LONG_REGISTER_NAME_ABCDEF_TWO") == 1 &&
+                find_register_by_name(&second, "CHIP262143_LONG_REGISTER_NAME_ABCDEF_TWO") == 1,
+                "Long names should still resolve");
+    TEST_ASSERT(find_register_by_name(NULL, "DATA_REG") == -1, "NULL system should fail");
+
+    // The perfect hash places every key of a large set
+    register_arena_t arena;
+    register_arena_init(&arena, 0);
+    uint32_t keys[1000];
+    int32_t values[1000];
+    for (int i = 0; i < 1000; i++) {
+        keys[i] = 0x40000000u + 0x1000u * (uint32_t)i;
+        values[i] = i;
+    }
+    register_phash_t phash;
+    TEST_ASSERT(register_phash_build(&phash, &arena, keys, values, 1000), "Perfect hash should build");
+    bool all_found = true;
+    for (int i = 0; i < 1000; i++) {
+        all_found = all_found && register_phash_lookup(&phash, keys[i]) == i;
+    }
+    TEST_ASSERT(all_found, "Every key should be found");
+    TEST_ASSERT(register_phash_lookup(&phash, 0x40000004u) == -1, "Missing key should not be found");
+    register_arena_reset(&arena);
+
+    cleanup_monitor_system(&first);
+    cleanup_monitor_system(&second);
+    TEST_PASS("Interned register names work correctly");
+}
+
+bool test_register_address_index(void) {
+    register_arena_t arena;
+    register_arena_init(&arena, 0);
+    monitor_system_t chips[3];
+    const monitor_system_t *systems[3];
+
+    for (int chip = 0; chip < 3; chip++) {
+        init_monitor_system_in(&chips[chip], &arena);
+        for (int reg = 0; reg < chips[chip].num_registers; reg++) {
+            chips[chip].regs.addresses[reg] += (uint32_t)chip * 0x1000u;
+        }
+        systems[chip] = &chips[chip];
+    }
+
+    // Chip 2 spans several pages
+    TEST_ASSERT(allocate_register_set(&chips[2], &arena, 2048), "Large chip should allocate");
+    for (int reg = 0; reg < 2048; reg++) {
+        define_register(&chips[2], reg, 0x40002000u + 4u * (uint32_t)reg, 0, 0xFFFFFFFFu, "WIDE_REG");
+    }
+
+    register_address_index_t index;
+    TEST_ASSERT(build_register_address_index(&index, &arena, systems, 3), "Index should build");
+    TEST_ASSERT(index.num_pages == 4, "Index should hold one page per chip page");
+
+    register_slot_t slot;
+    TEST_ASSERT(find_register_by_address(&index, 0x40001008u, &slot) && slot.chip == 1 && slot.reg == 2,
+                "Address should resolve to its chip and register");
+    TEST_ASSERT(find_register_by_address(&index, 0x40002000u + 4u * 2047u, &slot) &&
+                slot.chip == 2 && slot.reg == 2047, "Last register of a wide chip should resolve");
+    TEST_ASSERT(!find_register_by_address(&index, 0x40000010u, &slot), "Unused word should not resolve");
+    TEST_ASSERT(!find_register_by_address(&index, 0x40000002u, &slot), "Unaligned address should not resolve");
+    TEST_ASSERT(!find_register_by_address(&index, 0x50000000u, &slot), "Unmapped page should not resolve");
+    TEST_ASSERT(!find_register_by_address(NULL, 0x40000000u, &slot), "NULL index should fail");
+
+    // Shared addresses resolve to the lowest chip
+    chips[1].regs.addresses[0] = 0x40000004u;
+    TEST_ASSERT(build_register_address_index(&index, &arena, systems, 2), "Index should rebuild");
+    TEST_ASSERT(find_register_by_address(&index, 0x40000004u, &slot) && slot.chip == 0 && slot.reg == 1,
+                "Lowest chip should own a shared address");
+
+    for (int chip = 0; chip < 3; chip++) {
+        cleanup_monitor_system(&chips[chip]);
+    }
+    register_arena_reset(&arena);
+    TEST_PASS("Register address index works correctly");
+}
+
+bool test_validity_bitmap_counting(void) {
+    register_arena_t arena;
+    register_arena_init(&arena, 0);
+    monitor_system_t a, b;
+    init_monitor_system_in(&a, &arena);
+    init_monitor_system_in(&b, &arena);
+    TEST_ASSERT(allocate_register_set(&a, &arena, 200), "First system should allocate");
+    TEST_ASSERT(allocate_register_set(&b, &arena, 130), "Second system should allocate");
+
+    uint32_t seed = 7;
+    int expected_valid = 0;
+    for (int i = 0; i < 200; i++) {
+        seed = seed * 1103515245u + 12345u;
+        set_register_valid(&a, i, (seed >> 16) & 1u);
+        expected_valid += register_is_valid(&a, i);
+        if (i < 130) {
+            set_register_valid(&b, i, (seed >> 17) & 1u);
+        }
+    }
+    TEST_ASSERT(count_valid_registers(&a) == expected_valid, "Popcount should match the register count");
+
+    int expected_mismatches = 0;
+    for (int i = 0; i < 130; i++) {
+        expected_mismatches += (register_is_valid(&a, i) != register_is_valid(&b, i));
+    }
+    TEST_ASSERT(register_validity_mismatches(&a, &b) == expected_mismatches,
+                "XOR popcount should match the pairwise comparison");
+    TEST_ASSERT(register_validity_mismatches(&a, &a) == 0, "A system should match itself");
+    TEST_ASSERT(register_validity_mismatches(&a, NULL) == -1, "NULL system should fail");
+
+    // Bits past the last register are ignored
+    uint64_t bitmap[2] = {~0ull, ~0ull};
+    TEST_ASSERT(count_register_bits(bitmap, 70) == 70, "Tail bits should not be counted");
+    TEST_ASSERT(count_register_bits(NULL, 70) == 0, "NULL bitmap should count 0");
+
+    cleanup_monitor_system(&a);
+    cleanup_monitor_system(&b);
+    register_arena_reset(&arena);
+    TEST_PASS("Validity bitmap counting works correctly");
+}
+
+bool test_bitfield_register_validation(void) {
+    monitor_system_t system;
+    init_monitor_system(&system);
+    TEST_ASSERT(load_register_map(&system) == REGISTER_MAP_COUNT, "Register map should load");
+
+    // Values inside every range; ERROR_STATUS then fails on its fields only
+    for (int i = 0; i < REGISTER_MAP_COUNT; i++) {
+        set_register_value(&system, i, register_map_min[i]);
+    }
+    set_register_value(&system, REGMAP_STATUS_REG, 0x1ABCDEF0);
+    set_register_value(&system, REGMAP_ERROR_STATUS, 0xC004);  // Reserved severity
+    TEST_ASSERT(validate_system_registers(&system) == REGISTER_MAP_COUNT - 1,
+                "Only the reserved severity should fail");
+    TEST_ASSERT(!register_is_valid(&system, REGMAP_ERROR_STATUS), "ERROR_STATUS should be invalid");
+
+    set_register_value(&system, REGMAP_ERROR_STATUS, 0x8003);  // Two error sources
+    TEST_ASSERT(validate_system_registers(&system) == REGISTER_MAP_COUNT - 1,
+                "A value outside the source set should fail");
+    set_register_value(&system, REGMAP_ERROR_STATUS, 0x8008);
+    set_register_value(&system, REGMAP_ERROR_MASK, 0x0FFF);
+    TEST_ASSERT(validate_system_registers(&system) == REGISTER_MAP_COUNT,
+                "Allowed field values should pass");
+    set_register_value(&system, REGMAP_ERROR_MASK, 0x1FFF);
+    TEST_ASSERT(validate_system_registers(&system) == REGISTER_MAP_COUNT - 1,
+                "Set reserved bits should fail");
+
+    // Many lanes on one register agree with a direct field check
+    register_arena_t arena;
+    register_arena_init(&arena, 0);
+    register_field_spec_t specs[19];
+    for (int f = 0; f < 19; f++) {
+        uint8_t width = (uint8_t)(1 + f % 5);
+        specs[f] = (register_field_spec_t){f % 3, "F", (uint8_t)(f % 24), width, 1, 3,
+                                           (f % 2) ? 0x15u : 0};
+    }
+    register_field_checks_t checks;
+    TEST_ASSERT(compile_register_fields(&checks, &arena, specs, 19, 3), "Field specs should compile");
+
+    uint32_t seed = 5;
+    bool agree = true;
+    for (int round = 0; round < 64; round++) {
+        uint32_t values[3];
+        uint64_t expected = 0x7, bitmap = 0x7;
+        for (int r = 0; r < 3; r++) {
+            seed = seed * 1103515245u + 12345u;
+            values[r] = seed;
+        }
+        for (int f = 0; f < 19; f++) {
+            uint32_t field = (values[specs[f].reg] >> specs[f].shift) & ((1u << specs[f].width) - 1u);
+            bool ok = specs[f].allowed ? ((specs[f].allowed >> field) & 1u)
+                                       : (field >= specs[f].min && field <= specs[f].max);
+            expected &= ok ? ~0ull : ~(1ull << specs[f].reg);
+        }
+        validate_register_fields(&checks, values, &bitmap);
+        agree = agree && bitmap == expected;
+        for (int r = 0; r < 3; r++) {
+            agree = agree && register_fields_valid(&checks, values, r) == (bool)((expected >> r) & 1u);
+        }
+    }
+    TEST_ASSERT(agree, "Compiled field lanes should match direct field checks");
+
+    specs[0].reg = 3;
+    TEST_ASSERT(!compile_register_fields(&checks, &arena, specs, 19, 3), "Unknown register should fail");
+    register_arena_reset(&arena);
+
+    cleanup_monitor_system(&system);
+    TEST_PASS("Bitfield register validation works correctly");
+}
+
+/**
+ * Monitor Core Tests: Chip Fleets and Scheduling
+ */
+
+bool test_chip_fleet(void) {
+    TEST_ASSERT(create_chip_fleet(0) == NULL, "Empty fleet should be rejected");
+    TEST_ASSERT(create_chip_fleet(MAX_FLEET_CHIPS + 1) == NULL, "Oversized fleet should be rejected");
+
+    // Far more chips than the old fixed table held
+    chip_fleet_t *fleet = create_chip_fleet(2000);
+    TEST_ASSERT(fleet != NULL && fleet->num_chips == 2000 && fleet->active_chip_count == 2000,
+                "Fleet should hold every chip");
+    TEST_ASSERT(((uintptr_t)fleet->chips % REGISTER_ARENA_ALIGN) == 0 &&
+                sizeof(chip_system_t) % REGISTER_ARENA_ALIGN == 0,
+                "Chip records should be cache-line aligned");
+    TEST_ASSERT(chip_fleet_footprint(fleet) >= 2000 * sizeof(chip_system_t),
+                "Footprint should cover the chip records");
+
+    monitor_system_t *last = &fleet->chips[1999].monitor;
+    TEST_ASSERT(register_address(last, 0) == 0x40000000u + 1999u * CHIP_ADDRESS_STRIDE,
+                "Chip registers should be offset by the chip stride");
+
+    set_report_sink(&null_sink);
+    TEST_ASSERT(scan_all_chips_registers(fleet) == 2000 * last->num_registers,
+                "Full scan should validate every chip");
+    TEST_ASSERT(apply_register_update(fleet, register_address(last, 1), register_max(last, 1) + 1),
+                "Update should reach the last chip");
+    TEST_ASSERT(!register_is_valid(last, 1) && last->error_count == 1,
+                "Out-of-range update should invalidate the register");
+    TEST_ASSERT(!apply_register_update(fleet, 0x7FFFFFF0u, 0), "Unmapped address should be ignored");
+
+    // Live updates honour the chip's bitfield rules as well as its bounds
+    register_arena_t field_arena;
+    register_arena_init(&field_arena, 0);
+    uint32_t in_range = register_min(last, 2);
+    register_field_spec_t odd_bit = {2, "LSB", 0, 1, ~in_range & 1u, ~in_range & 1u, 0};
+    register_field_checks_t checks;
+    TEST_ASSERT(compile_register_fields(&checks, &field_arena, &odd_bit, 1, last->num_registers),
+                "Field spec should compile");
+    last->field_checks = &checks;
+    TEST_ASSERT(apply_register_update(fleet, register_address(last, 2), in_range) &&
+                !register_is_valid(last, 2) && last->error_count == 2,
+                "In-range update with a bad field should invalidate the register");
+    TEST_ASSERT(apply_register_update(fleet, register_address(last, 2), in_range ^ 1u) &&
+                register_is_valid(last, 2) == (register_value(last, 2) <= register_max(last, 2)),
+                "Update with a good field should only depend on the bounds");
+    last->field_checks = NULL;
+    register_arena_reset(&field_arena);
+    set_report_sink(NULL);
+
+    destroy_chip_fleet(fleet);
+    destroy_chip_fleet(NULL);
+
+    TEST_PASS("Chip fleet works correctly");
+}
+
+/**
+ * @brief Whether every chip of two fleets holds the same scan state
+ */
+static bool same_fleet_state(const chip_fleet_t *a, const chip_fleet_t *b) {
+    bool same = a->num_chips == b->num_chips;
+    for (int chip = 0; same && chip < a->num_chips; chip++) {
+        const monitor_system_t *x = &a->chips[chip].monitor;
+        const monitor_system_t *y = &b->chips[chip].monitor;
+        same = x->error_count == y->error_count && x->sim_sequence == y->sim_sequence &&
+               x->num_registers == y->num_registers &&
+               memcmp(x->regs.values, y->regs.values, (size_t)x->num_registers * sizeof(uint32_t)) == 0 &&
+               memcmp(x->regs.valid, y->regs.valid,
+                      REGISTER_BITMAP_WORDS(x->num_registers) * sizeof(uint64_t)) == 0;
+    }
+    return same;
+}
+
+bool test_parallel_fleet_scan(void) {
+    chip_fleet_t *serial = create_chip_fleet(3000);
+    chip_fleet_t *parallel = create_chip_fleet(3000);
+    worker_pool_t *pool = create_worker_pool(4);
+    task_scheduler_t *scheduler = create_task_scheduler(pool);
+    TEST_ASSERT(serial != NULL && parallel != NULL && pool != NULL && scheduler != NULL,
+                "Fleets and pool should start");
+    TEST_ASSERT(worker_pool_size(pool) == 4, "Pool should have the requested workers");
+    TEST_ASSERT(create_worker_pool(-1) == NULL, "Negative worker count should be rejected");
+
+    set_report_sink(&null_sink);
+    int expected = scan_all_chips_registers(serial);
+    TEST_ASSERT(scan_all_chips_registers_parallel(parallel, scheduler) == expected,
+                "Parallel totals should match the serial scan");
+    TEST_ASSERT(same_fleet_state(serial, parallel), "Every chip should be scanned exactly as in the serial scan");
+
+    // Chip 1500 is high priority; with every register out of range it aborts the scan
+    for (int reg = 0; reg < 4; reg++) {
+        serial->chips[1500].monitor.regs.max[reg] = 0;
+        parallel->chips[1500].monitor.regs.max[reg] = 0;
+    }
+    expected = scan_all_chips_registers(serial);
+    TEST_ASSERT(scan_all_chips_registers_parallel(parallel, scheduler) == expected,
+                "Aborted parallel scan should count the chips before the abort");
+    TEST_ASSERT(parallel->chips[1500].monitor.error_count == serial->chips[1500].monitor.error_count,
+                "Aborting chip should stop at the same register");
+    TEST_ASSERT(same_fleet_state(serial, parallel), "Chips past the abort should be left untouched");
+    TEST_ASSERT(scan_all_chips_registers_parallel(parallel, NULL) == expected,
+                "Scan without a scheduler should run inline");
+    set_report_sink(NULL);
+
+    destroy_task_scheduler(scheduler);
+    destroy_worker_pool(pool);
+    destroy_chip_fleet(serial);
+    destroy_chip_fleet(parallel);
+
+    TEST_PASS("Parallel fleet scan works correctly");
+}
+
+/**
+ * @brief Scheduler test task: mark the item and do work proportional to it
+ */
+static void count_item_task(void *context, uint32_t item, int worker) {
+    uint32_t *runs = context;
+    volatile uint32_t spin = 0;
+    (void)worker;
+
+    for (uint32_t i = 0; i < item % 97; i++) {
+        spin += i;
+    }
+    runs[item]++;
+}
+
+bool test_work_stealing_scheduler(void) {
+    enum { ITEMS = 20000 };
+    static uint32_t runs[ITEMS];
+    worker_pool_t *pool = create_worker_pool(4);
+    task_scheduler_t *scheduler = create_task_scheduler(pool);
+    TEST_ASSERT(scheduler != NULL && task_scheduler_workers(scheduler) == 4,
+                "Scheduler should run on every worker of the pool");
+
+    // Uneven items, several runs of the same scheduler
+    bool once = true;
+    for (int round = 0; round < 3; round++) {
+        memset(runs, 0, sizeof(runs));
+        run_scheduled_tasks(scheduler, ITEMS, count_item_task, runs);
+        for (int i = 0; i < ITEMS; i++) {
+            once = once && runs[i] == 1;
+        }
+    }
+    TEST_ASSERT(once, "Every item should run exactly once");
+
+    memset(runs, 0, sizeof(runs));
+    run_scheduled_tasks(NULL, 3, count_item_task, runs);
+    TEST_ASSERT(runs[0] == 1 && runs[2] == 1 && runs[3] == 0, "No scheduler should run items inline");
+
+    // Correlation rows are uneven; the summary must not depend on the schedule
+    chip_fleet_t *fleet = create_chip_fleet(400);
+    TEST_ASSERT(fleet != NULL, "Fleet should be created");
+    for (int chip = 0; chip < 400; chip++) {
+        fleet->chips[chip].monitor.voltage = 3.0f + 0.1f * (float)(chip % 7);
+        fleet->chips[chip].monitor.temperature = 25.0f + (float)(chip % 30);
+    }
+    deactivate_chip(fleet, 17);
+    chip_correlation_summary_t inline_summary;
+    chip_correlation_summary_t stolen_summary;
+    TEST_ASSERT(summarize_chip_correlation(fleet, NULL, &inline_summary) &&
+                summarize_chip_correlation(fleet, scheduler, &stolen_summary), "Summaries should compute");
+    TEST_ASSERT(inline_summary.pairs == 399L * 398L / 2, "Every pair of active chips should be compared");
+    TEST_ASSERT(memcmp(&inline_summary, &stolen_summary, sizeof(inline_summary)) == 0 &&
+                stolen_summary.voltage_warnings > 0 && stolen_summary.temperature_warnings > 0,
+                "Scheduled summary should match the inline one");
+
+    destroy_chip_fleet(fleet);
+
+    // Stolen tasks may read chips past an abort; they must end up as in the serial scan.
+    // Every 50th chip carries the full register map, so the chips are uneven.
+    chip_fleet_t *serial = create_chip_fleet(2000);
+    chip_fleet_t *stolen = create_chip_fleet(2000);
+    TEST_ASSERT(serial != NULL && stolen != NULL, "Fleets should be created");
+    for (int chip = 0; chip < 2000; chip += 50) {
+        load_register_map(&serial->chips[chip].monitor);
+        load_register_map(&stolen->chips[chip].monitor);
+    }
+    set_report_sink(&null_sink);
+    bool matched = true;
+    const int abort_chips[] = {1497, 99, 0};  // High priority; each aborts earlier than the last
+    for (int round = 0; round < 3; round++) {
+        monitor_system_t *a = &serial->chips[abort_chips[round]].monitor;
+        monitor_system_t *b = &stolen->chips[abort_chips[round]].monitor;
+        for (int reg = 0; reg < a->num_registers; reg++) {
+            a->regs.max[reg] = 0;
+            b->regs.max[reg] = 0;
+        }
+        int expected = scan_all_chips_registers(serial);
+        matched = matched && scan_all_chips_registers_parallel(stolen, scheduler) == expected &&
+                  same_fleet_state(serial, stolen);
+    }
+    set_report_sink(NULL);
+    TEST_ASSERT(matched, "Error counts and simulated sequences should match the serial scan");
+    destroy_chip_fleet(serial);
+    destroy_chip_fleet(stolen);
+
+    destroy_task_scheduler(scheduler);
+    destroy_worker_pool(pool);
+
+    TEST_PASS("Work-stealing scheduler works correctly");
+}
+
+/**
+ * @brief Timer wheel state for the wheel test: rearms every timer with its own period
+ */
+typedef struct {
+    timer_wheel_t *wheel;
+    const uint32_t *periods;
+    uint32_t *fires;
+    bool on_time;
+} wheel_test_t;
+
+static void rearm_test_timer(void *context, uint32_t timer, uint64_t deadline) {
+    wheel_test_t *test = context;
+    test->on_time = test->on_time && deadline == test->wheel->now;
+    test->fires[timer]++;
+    timer_wheel_schedule(test->wheel, timer, deadline + test->periods[timer]);
+}
+
+bool test_timer_wheel(void) {
+    enum { TIMERS = 600, TICKS = 300000 };
+    static uint32_t periods[TIMERS];
+    static uint32_t fires[TIMERS];
+    timer_wheel_t wheel;
+    TEST_ASSERT(timer_wheel_init(&wheel, TIMERS), "Timer wheel should initialize");
+
+    // Periods from one tick to beyond two levels of the wheel
+    for (uint32_t timer = 0; timer < TIMERS; timer++) {
+        periods[timer] = 1 + (timer * timer * 37u) % 9000u;
+        fires[timer] = 0;
+        TEST_ASSERT(timer_wheel_schedule(&wheel, timer, periods[timer]), "Timer should be scheduled");
+    }
+    periods[1] = 280000;
+    timer_wheel_schedule(&wheel, 1, periods[1]);
+    TEST_ASSERT(!timer_wheel_schedule(&wheel, TIMERS, 5), "Out-of-range timer should be rejected");
+
+    wheel_test_t test = {&wheel, periods, fires, true};
+    size_t expired = 0;
+    for (uint64_t tick = 1; tick <= TICKS / 2; tick++) {
+        expired += timer_wheel_advance(&wheel, tick, rearm_test_timer, &test);
+    }
+    expired += timer_wheel_advance(&wheel, TICKS, rearm_test_timer, &test);  // One long jump
+
+    bool counts = true;
+    size_t total = 0;
+    for (uint32_t timer = 0; timer < TIMERS; timer++) {
+        counts = counts && fires[timer] == TICKS / periods[timer];
+        total += fires[timer];
+    }
+    TEST_ASSERT(test.on_time, "Timers should expire exactly at their deadline");
+    TEST_ASSERT(counts && expired == total, "Every timer should fire once per period");
+
+    // Cancelled timers stay quiet; a past deadline fires on the next tick
+    TEST_ASSERT(timer_wheel_cancel(&wheel, 0) && !timer_wheel_pending(&wheel, 0),
+                "Cancelled timer should not be pending");
+    TEST_ASSERT(!timer_wheel_cancel(&wheel, 0), "Cancelling twice should fail");
+    uint32_t before = fires[0];
+    uint32_t late_before = fires[2];
+    periods[2] = TICKS;
+    timer_wheel_schedule(&wheel, 2, 10);
+    timer_wheel_advance(&wheel, TICKS + 1, rearm_test_timer, &test);
+    TEST_ASSERT(fires[2] == late_before + 1 && test.on_time, "Past deadline should fire on the next tick");
+    timer_wheel_advance(&wheel, TICKS + 100, rearm_test_timer, &test);
+    TEST_ASSERT(fires[0] == before, "Cancelled timer should not fire");
+
+    timer_wheel_destroy(&wheel);
+
+    TEST_PASS("Timer wheel works correctly");
+}
+
+bool test_active_chip_set(void) {
+    enum { CHIPS = 200 };
+    static int visits[CHIPS];
+    chip_fleet_t *fleet = create_chip_fleet(CHIPS);
+    TEST_ASSERT(fleet != NULL && next_active_chip(fleet, -1) == 0 && next_active_chip(fleet, CHIPS - 1) == -1,
+                "New fleet should have every chip active");
+
+    // Deactivate behind, at and ahead of the walk while walking
+    memset(visits, 0, sizeof(visits));
+    int previous = -1;
+    bool ordered = true;
+    for (int chip = next_active_chip(fleet, -1); chip >= 0; chip = next_active_chip(fleet, chip)) {
+        ordered = ordered && chip > previous;
+        previous = chip;
+        visits[chip]++;
+        if (chip % 3 == 0) {
+            deactivate_chip(fleet, chip);
+        }
+        if (chip % 10 == 1) {
+            deactivate_chip(fleet, chip + 2);
+        }
+        if (chip > 0 && chip % 7 == 0) {
+            deactivate_chip(fleet, chip - 1);
+        }
+    }
+
+    bool exact = true;
+    int active = 0;
+    for (int chip = 0; chip < CHIPS; chip++) {
+        bool dropped_ahead = (chip % 10 == 3);
+        exact = exact && visits[chip] == (dropped_ahead ? 0 : 1);
+        active += chip_is_active(fleet, chip);
+    }
+    TEST_ASSERT(ordered && exact, "Walk should visit every chip still active exactly once, in order");
+    TEST_ASSERT(active == fleet->active_chip_count, "Active count should follow deactivations");
+    TEST_ASSERT(!deactivate_chip(fleet, 0) && !deactivate_chip(fleet, CHIPS) && !deactivate_chip(fleet, -1),
+                "Inactive or unknown chips should not be deactivated");
+
+    int chips[CHIPS];
+    int count = list_active_chips(fleet, chips);
+    TEST_ASSERT(count == fleet->active_chip_count && chips[0] == 1, "Active list should be dense and ordered");
+
+    // Loops over the active set skip the holes
+    chip_correlation_summary_t summary;
+    TEST_ASSERT(summarize_chip_correlation(fleet, NULL, &summary) &&
+                summary.pairs == (long)count * (count - 1) / 2, "Correlation should pair active chips only");
+
+    while (fleet->active_chip_count > 0) {
+        deactivate_chip(fleet, next_active_chip(fleet, -1));
+    }
+    TEST_ASSERT(next_active_chip(fleet, -1) == -1 && list_active_chips(fleet, chips) == 0,
+                "Fleet without active chips should have nothing to walk");
+
+    destroy_chip_fleet(fleet);
+
+    TEST_PASS("Active chip set works correctly");
+}
+
 /**
  * Task 3 Tests: Modular Functions Validation
  */
@@ -319,6 +1630,7 @@ bool test_run_comprehensive_test(void) {
     passed = run_comprehensive_test(NULL);
     TEST_ASSERT(passed == 0, "NULL pointer should return 0");
 
+    cleanup_monitor_system(&system);
     TEST_PASS("Comprehensive test suite works correctly");
 }
 
@@ -378,6 +1690,7 @@ bool test_attempt_error_recovery(void) {
     result = attempt_error_recovery(NULL, ERROR_VOLTAGE_LOW);
     TEST_ASSERT(!result, "NULL pointer recovery should fail");
 
+    cleanup_monitor_system(&system);
     TEST_PASS("Error recovery works correctly");
 }
 
@@ -412,6 +1725,7 @@ bool test_system_integration(void) {
     system_status_t status = determine_system_status(3.3f, 25.0f, 0.5f);
     TEST_ASSERT(status == STATUS_NORMAL, "Normal conditions should give normal status");
 
+    cleanup_monitor_system(&system);
     TEST_PASS("System integration works correctly");
 }
 
@@ -482,6 +1796,39 @@ int main(void) {
     run_test("Register Counting", test_count_valid_registers);
     run_test("Register Updates", test_update_all_registers);
 
+    // Monitor Core Tests: Register Access and Transports
+    printf("\n=== Monitor Core: Register Access and Transport Tests ===\n");
+    run_test("Bulk Register Read", test_read_registers_bulk);
+    run_test("Register File Backend", test_register_file_backend);
+    run_test("Shadow Register Cache", test_shadow_register_cache);
+    run_test("Register Transport Selection", test_register_transport_selection);
+    run_test("Register Trace Replay", test_register_trace_replay);
+    run_test("Seeded Simulated Registers", test_seeded_simulated_registers);
+    run_test("Reporting Sinks", test_report_sinks);
+    run_test("Register Poller", test_register_poller);
+    run_test("Checked Register Reads", test_checked_register_reads);
+
+    // Monitor Core Tests: Validation and Register Storage
+    printf("\n=== Monitor Core: Validation and Register Storage Tests ===\n");
+    run_test("Batch Register Validation", test_validate_registers_batch);
+    run_test("Batch Status Classification", test_system_status_batch);
+    run_test("Lookup-Table Status Classifier", test_classify_system_status);
+    run_test("Generated Register Map", test_generated_register_map);
+    run_test("Register Store", test_register_store);
+    run_test("Sized Register Sets", test_sized_register_sets);
+    run_test("Interned Register Names", test_interned_register_names);
+    run_test("Register Address Index", test_register_address_index);
+    run_test("Validity Bitmap Counting", test_validity_bitmap_counting);
+    run_test("Bitfield Register Validation", test_bitfield_register_validation);
+
+    // Monitor Core Tests: Chip Fleets and Scheduling
+    printf("\n=== Monitor Core: Chip Fleet and Scheduling Tests ===\n");
+    run_test("Chip Fleet", test_chip_fleet);
+    run_test("Parallel Fleet Scan", test_parallel_fleet_scan);
+    run_test("Work-Stealing Scheduler", test_work_stealing_scheduler);
+    run_test("Timer Wheel", test_timer_wheel);
+    run_test("Active Chip Set", test_active_chip_set);
+
     // Task 3: Modular Functions Tests
     printf("\n=== Task 3: Modular Functions Tests ===\n");
     run_test("Voltage Level Testing", test_voltage_level_function);